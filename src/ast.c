@@ -23,7 +23,7 @@ is_rule(struct rule *rule, ...)
 }
 
 struct astnode *
-create_translation_unit_node(struct listnode *list, struct rule *rule)
+create_translation_unit_node(struct astnode **rhs, struct rule *rule)
 {
     unsigned int node_size;
     struct ast_translation_unit *node;
@@ -33,28 +33,25 @@ create_translation_unit_node(struct listnode *list, struct rule *rule)
     {
         node_size = sizeof(struct ast_translation_unit) +
                     sizeof(struct ast_translation_unit *);
-        node = malloc(node_size);
-        memset(node, 0, node_size);
+        node = arena_alloc(node_size);
 
-        /* index 1 is AST_EXTERNAL_DECLARATION astnode */
-        /* index 0 is AST_EXTERNAL_DECLARATION state */
-        node->translation_unit_items[0] = list_item(&list, 1);
+        /* rhs[0] is AST_EXTERNAL_DECLARATION */
+        node->translation_unit_items[0] = rhs[0];
         node->translation_unit_items_size = 1;
     }
     if (is_rule(rule, AST_TRANSLATION_UNIT, AST_EXTERNAL_DECLARATION))
     {
-        /* index 3 is AST_TRANSLATION_UNIT astnode */
-        /* index 2 is AST_TRANSLATION_UNIT state */
-        node = list_item(&list, 3);
+        /* rhs[0] is AST_TRANSLATION_UNIT */
+        node = (struct ast_translation_unit *)rhs[0];
 
         node_size = sizeof(struct ast_translation_unit) +
             sizeof(struct ast_translation_unit *) *
-            (node->translation_unit_items_size + 1);
-        node = realloc(node, node_size);
+            node->translation_unit_items_size;
+        node = arena_realloc(node, node_size,
+                             node_size + sizeof(struct ast_translation_unit *));
 
-        /* index 1 is AST_EXTERNAL_DECLARATION astnode */
-        /* index 0 is AST_EXTERNAL_DECLARATION state */
-        child = list_item(&list, 1);
+        /* rhs[1] is AST_EXTERNAL_DECLARATION */
+        child = rhs[1];
 
         node->translation_unit_items[node->translation_unit_items_size] = child;
         node->translation_unit_items_size += 1;
@@ -65,13 +62,13 @@ create_translation_unit_node(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_elided_node(struct listnode *list, struct rule *rule)
+create_elided_node(struct astnode **rhs, struct rule *rule)
 {
     struct astnode *node;
 
     assert(rule->length_of_nodes == 1);
 
-    node = list_item(&list, 1);
+    node = rhs[0];
     node->type = rule->type;
 
     /*
@@ -87,21 +84,20 @@ create_elided_node(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_function_definition(struct listnode *list, struct rule *rule)
+create_function_definition(struct astnode **rhs, struct rule *rule)
 {
     struct ast_function *node;
 
-    node = malloc(sizeof(struct ast_function));
-    memset(node, 0, sizeof(struct ast_function));
+    node = arena_alloc(sizeof(struct ast_function));
 
     if (is_rule(rule,
         AST_DECLARATION_SPECIFIERS, AST_DECLARATOR, AST_COMPOUND_STATEMENT))
     {
-        /* index 5 is AST_DECLARATION_SPECIFIERS astnode */
-        /* index 3 is AST_DECLARATOR state */
-        /* index 1 is AST_COMPOUND_STATEMENT state */
-        node->function_declarator = list_item(&list, 3);
-        node->statements = list_item(&list, 1);
+        /* rhs[0] is AST_DECLARATION_SPECIFIERS */
+        /* rhs[1] is AST_DECLARATOR */
+        /* rhs[2] is AST_COMPOUND_STATEMENT */
+        node->function_declarator = (struct ast_declarator *)rhs[1];
+        node->statements = (struct ast_compound_statement *)rhs[2];
     }
 
     node->type = rule->type;
@@ -109,24 +105,31 @@ create_function_definition(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_declaration(struct listnode *list, struct rule *rule)
+create_declaration(struct astnode **rhs, struct rule *rule)
 {
     struct ast_declaration *node, *child;
 
     if (is_rule(rule, AST_DECLARATION_SPECIFIERS, AST_SEMICOLON))
     {
-        /* index 3 is AST_DECLARATION_SPECIFIERS astnode */
-        /* index 1 is AST_SEMICOLON state */
-        node = list_item(&list, 3);
+        /* rhs[0] is AST_DECLARATION_SPECIFIERS */
+        /* rhs[1] is AST_SEMICOLON */
+        node = (struct ast_declaration *)rhs[0];
     }
     else if (is_rule(rule,
              AST_DECLARATION_SPECIFIERS, AST_INIT_DECLARATOR_LIST, AST_SEMICOLON))
     {
-        /* index 5 is AST_DECLARATION_SPECIFIERS astnode */
-        /* index 3 is AST_INIT_DECLARATOR_LIST state */
-        /* index 1 is AST_SEMICOLON state */
-        node = list_item(&list, 5);
-        child = list_item(&list, 3);
+        /* rhs[0] is AST_DECLARATION_SPECIFIERS */
+        /* rhs[1] is AST_INIT_DECLARATOR_LIST */
+        /* rhs[2] is AST_SEMICOLON */
+        node = (struct ast_declaration *)rhs[0];
+        child = (struct ast_declaration *)rhs[1];
+
+        /*
+         * Make room for the declarators after the first.
+         */
+        node = arena_realloc(node, sizeof(struct ast_declaration),
+            sizeof(struct ast_declaration) +
+            sizeof(struct ast_declarator *) * (child->declarators_size - 1));
 
         node->declarators_size = child->declarators_size;
         memcpy(node->declarators, child->declarators,
@@ -138,7 +141,7 @@ create_declaration(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_declaration_list(struct listnode *list, struct rule *rule)
+create_declaration_list(struct astnode **rhs, struct rule *rule)
 {
     unsigned int node_size;
     struct ast_declaration_list *node;
@@ -146,26 +149,27 @@ create_declaration_list(struct listnode *list, struct rule *rule)
 
     if (is_rule(rule, AST_DECLARATION_LIST, AST_DECLARATION))
     {
-        /* index 3 is AST_DECLARATION_LIST astnode */
-        /* index 1 is AST_DECLARATION astnode */
-        node = list_item(&list, 3);
+        /* rhs[0] is AST_DECLARATION_LIST */
+        /* rhs[1] is AST_DECLARATION */
+        node = (struct ast_declaration_list *)rhs[0];
 
         node_size = sizeof(struct ast_declaration_list) +
-                    sizeof(struct ast_declaration *) * (node->size + 1);
-        node = realloc(node, node_size);
-        child = list_item(&list, 1);
+                    sizeof(struct ast_declaration *) * node->size;
+        node = arena_realloc(node, node_size,
+                             node_size + sizeof(struct ast_declaration *));
+        child = (struct ast_declaration *)rhs[1];
 
         node->items[node->size] = child;
         node->size += 1;
     }
     else if (is_rule(rule, AST_DECLARATION))
     {
-        /* index 1 is AST_DECLARATION astnode */
-        node_size = sizeof(struct ast_declaration) +
+        /* rhs[0] is AST_DECLARATION */
+        node_size = sizeof(struct ast_declaration_list) +
                     sizeof(struct ast_declaration *);
-        node = malloc(node_size);
+        node = arena_alloc(node_size);
 
-        node->items[0] = list_item(&list, 1);
+        node->items[0] = (struct ast_declaration *)rhs[0];
         node->size = 1;
     }
 
@@ -174,7 +178,7 @@ create_declaration_list(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_parameter_list(struct listnode *list, struct rule *rule)
+create_parameter_list(struct astnode **rhs, struct rule *rule)
 {
     unsigned int node_size;
     struct ast_parameter_type_list *node;
@@ -182,26 +186,27 @@ create_parameter_list(struct listnode *list, struct rule *rule)
 
     if (is_rule(rule, AST_PARAMETER_LIST, AST_COMMA, AST_PARAMETER_DECLARATION))
     {
-        /* index 5 is AST_PARAMETER_LIST astnode */
-        /* index 1 is AST_PARAMETER_DECLARATION astnode */
-        node = list_item(&list, 5);
+        /* rhs[0] is AST_PARAMETER_LIST */
+        /* rhs[2] is AST_PARAMETER_DECLARATION */
+        node = (struct ast_parameter_type_list *)rhs[0];
 
         node_size = sizeof(struct ast_declaration) +
-                    sizeof(struct ast_declaration *) * (node->size + 1);
-        node = realloc(node, node_size);
-        child = list_item(&list, 1);
+                    sizeof(struct ast_declaration *) * node->size;
+        node = arena_realloc(node, node_size,
+                             node_size + sizeof(struct ast_declaration *));
+        child = (struct ast_declaration *)rhs[2];
 
         node->items[node->size] = child;
         node->size += 1;
     }
     else if (is_rule(rule, AST_PARAMETER_DECLARATION))
     {
-        /* index 1 is AST_PARAMETER_DECLARATION astnode */
-        child = list_item(&list, 1);
+        /* rhs[0] is AST_PARAMETER_DECLARATION */
+        child = (struct ast_declaration *)rhs[0];
 
         node_size = sizeof(struct ast_declaration) +
                     sizeof(struct ast_declaration *);
-        node = malloc(node_size);
+        node = arena_alloc(node_size);
 
         node->items[0] = child;
         node->size = 1;
@@ -212,26 +217,26 @@ create_parameter_list(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_parameter_declaration(struct listnode *list, struct rule *rule)
+create_parameter_declaration(struct astnode **rhs, struct rule *rule)
 {
     struct ast_declaration *node;
     struct ast_declarator *child;
 
     if (is_rule(rule, AST_DECLARATION_SPECIFIERS))
     {
-        /* index 1 is AST_DECLARATION_SPECIFIERS astnode */
-        node = list_item(&list, 1);
+        /* rhs[0] is AST_DECLARATION_SPECIFIERS */
+        node = (struct ast_declaration *)rhs[0];
         node->type = rule->type;
         return (struct astnode *)node;
     }
     else if (is_rule(rule, AST_DECLARATION_SPECIFIERS, AST_DECLARATOR) ||
              is_rule(rule, AST_DECLARATION_SPECIFIERS, AST_ABSTRACT_DECLARATOR))
     {
-        /* index 3 is AST_DECLARATION_SPECIFIERS astnode */
-        node = list_item(&list, 3);
+        /* rhs[0] is AST_DECLARATION_SPECIFIERS */
+        node = (struct ast_declaration *)rhs[0];
 
-        /* index 1 is [ AST_DECLARATOR | AST_ABSTRACT_DECLARATOR ] astnode */
-        child = list_item(&list, 1);
+        /* rhs[1] is [ AST_DECLARATOR | AST_ABSTRACT_DECLARATOR ] */
+        child = (struct ast_declarator *)rhs[1];
 
         node->declarators[0] = child;
         node->declarators_size = 1;
@@ -242,14 +247,14 @@ create_parameter_declaration(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_initializer(struct listnode *list, struct rule *rule)
+create_initializer(struct astnode **rhs, struct rule *rule)
 {
     struct ast_initializer *node;
 
     if (is_rule(rule, AST_ASSIGNMENT_EXPRESSION))
     {
-        node = malloc(sizeof(struct ast_initializer));
-        node->expression = list_item(&list, 1);
+        node = arena_alloc(sizeof(struct ast_initializer));
+        node->expression = (struct ast_expression *)rhs[0];
     }
 
     node->type = rule->type;
@@ -257,13 +262,13 @@ create_initializer(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_expression_statement(struct listnode *list, struct rule *rule)
+create_expression_statement(struct astnode **rhs, struct rule *rule)
 {
     struct astnode *node;
 
     if (is_rule(rule, AST_EXPRESSION, AST_SEMICOLON))
     {
-        node = list_item(&list, 3);
+        node = rhs[0];
     }
 
     node->type = rule->type;
@@ -271,26 +276,25 @@ create_expression_statement(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_compound_statement(struct listnode *list, struct rule *rule)
+create_compound_statement(struct astnode **rhs, struct rule *rule)
 {
     struct ast_compound_statement *node;
 
-    node = malloc(sizeof(struct ast_compound_statement));
-    memset(node, 0, sizeof(struct ast_compound_statement));
+    node = arena_alloc(sizeof(struct ast_compound_statement));
 
     if (is_rule(rule, AST_LBRACE, AST_STATEMENT_LIST, AST_RBRACE))
     {
-        node->statements = list_item(&list, 3);
+        node->statements = (struct ast_statement_list *)rhs[1];
     }
     else if (is_rule(rule, AST_LBRACE, AST_DECLARATION_LIST, AST_RBRACE))
     {
-        node->declarations = list_item(&list, 3);
+        node->declarations = (struct ast_declaration_list *)rhs[1];
     }
     else if (is_rule(rule,
              AST_LBRACE, AST_DECLARATION_LIST, AST_STATEMENT_LIST, AST_RBRACE))
     {
-        node->statements = list_item(&list, 3);
-        node->declarations = list_item(&list, 5);
+        node->statements = (struct ast_statement_list *)rhs[2];
+        node->declarations = (struct ast_declaration_list *)rhs[1];
     }
 
     node->type = rule->type;
@@ -298,7 +302,7 @@ create_compound_statement(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_statement_list(struct listnode *list, struct rule *rule)
+create_statement_list(struct astnode **rhs, struct rule *rule)
 {
     unsigned int node_size;
     struct ast_statement_list *node, *child;
@@ -307,24 +311,24 @@ create_statement_list(struct listnode *list, struct rule *rule)
     if (is_rule(rule, AST_STATEMENT))
     {
         node_size = sizeof(struct ast_statement_list) + (sizeof(struct astnode *));
-        node = malloc(node_size);
-        memset(node, 0, node_size);
+        node = arena_alloc(node_size);
 
-        /* index 1 is AST_STATEMENT astnode */
-        node->items[0] = list_item(&list, 1);
+        /* rhs[0] is AST_STATEMENT */
+        node->items[0] = rhs[0];
         node->size = 1;
     }
     else if (is_rule(rule, AST_STATEMENT_LIST, AST_STATEMENT))
     {
-        /* index 3 is AST_STATEMENT_LIST astnode */
-        /* index 1 is AST_STATEMENT astnode */
-        child = list_item(&list, 3);
+        /* rhs[0] is AST_STATEMENT_LIST */
+        /* rhs[1] is AST_STATEMENT */
+        child = (struct ast_statement_list *)rhs[0];
 
         node_size = sizeof(struct ast_statement_list) +
-            (sizeof(struct astnode *) * (child->size + 1));
-        node = realloc(child, node_size);
+            (sizeof(struct astnode *) * child->size);
+        node = arena_realloc(child, node_size,
+                             node_size + sizeof(struct astnode *));
 
-        node->items[node->size] = list_item(&list, 1);
+        node->items[node->size] = rhs[1];
         node->size += 1;
     }
     node->type = rule->type;
@@ -333,29 +337,28 @@ create_statement_list(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_selection_statement(struct listnode *list, struct rule *rule)
+create_selection_statement(struct astnode **rhs, struct rule *rule)
 {
 
     struct astnode *expression;
     struct astnode *statement1;
 
     struct ast_selection_statement *node;
-    node = malloc(sizeof(struct ast_selection_statement));
-    memset(node, 0, sizeof(struct ast_selection_statement));
+    node = arena_alloc(sizeof(struct ast_selection_statement));
 
     if (is_rule(rule,
         AST_IF, AST_LPAREN, AST_EXPRESSION, AST_RPAREN, AST_STATEMENT))
     {
-        node->expression = list_item(&list, 5);
-        node->statement1 = list_item(&list, 1);
+        node->expression = (struct ast_binary_op *)rhs[2];
+        node->statement1 = rhs[4];
     }
     else if (is_rule(rule,
         AST_IF, AST_LPAREN, AST_EXPRESSION, AST_RPAREN, AST_STATEMENT,
         AST_ELSE, AST_STATEMENT))
     {
-        node->expression = list_item(&list, 9);
-        node->statement1 = list_item(&list, 5);
-        node->statement2 = list_item(&list, 1);
+        node->expression = (struct ast_binary_op *)rhs[2];
+        node->statement1 = rhs[4];
+        node->statement2 = rhs[6];
     }
 
     node->type = rule->type;
@@ -363,7 +366,7 @@ create_selection_statement(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_iteration_statement(struct listnode *list, struct rule *rule)
+create_iteration_statement(struct astnode **rhs, struct rule *rule)
 {
     struct astnode *expression1;
     struct astnode *expression2;
@@ -371,17 +374,16 @@ create_iteration_statement(struct listnode *list, struct rule *rule)
     struct astnode *statement;
 
     struct ast_iteration_statement *node;
-    node = malloc(sizeof(struct ast_iteration_statement));
-    memset(node, 0, sizeof(struct ast_iteration_statement));
+    node = arena_alloc(sizeof(struct ast_iteration_statement));
 
     if (is_rule(rule,
         AST_FOR, AST_LPAREN, AST_EXPRESSION, AST_SEMICOLON, AST_EXPRESSION,
         AST_SEMICOLON, AST_EXPRESSION, AST_RPAREN, AST_STATEMENT))
     {
-        node->expression1 = list_item(&list, 13);
-        node->expression2 = list_item(&list, 9);
-        node->expression3 = list_item(&list, 5);
-        node->statement = list_item(&list, 1);
+        node->expression1 = rhs[2];
+        node->expression2 = rhs[4];
+        node->expression3 = rhs[6];
+        node->statement = rhs[8];
     }
 
     node->type = rule->type;
@@ -389,13 +391,13 @@ create_iteration_statement(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_jump_statement(struct listnode *list, struct rule *rule)
+create_jump_statement(struct astnode **rhs, struct rule *rule)
 {
     struct astnode *node;
 
     if (is_rule(rule, AST_RETURN, AST_EXPRESSION, AST_SEMICOLON))
     {
-        node = list_item(&list, 3);
+        node = rhs[1];
     }
 
     node->type = rule->type;
@@ -403,7 +405,7 @@ create_jump_statement(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_assignment_expression(struct listnode *list, struct rule *rule)
+create_assignment_expression(struct astnode **rhs, struct rule *rule)
 {
     /*
      * TODO: This is identical to create_binary_op(). Is a duplicate function
@@ -411,15 +413,14 @@ create_assignment_expression(struct listnode *list, struct rule *rule)
      */
 
     struct ast_binary_op *node;
-    node = malloc(sizeof(struct ast_binary_op));
-    memset(node, 0, sizeof(struct ast_binary_op));
+    node = arena_alloc(sizeof(struct ast_binary_op));
 
-    /* index 1 is right astnode */
-    /* index 3 is operator astnode */
-    /* index 5 is right astnode */
-    node->left = list_item(&list, 5);
-    node->op = ((struct astnode *)list_item(&list, 3))->type;
-    node->right = list_item(&list, 1);
+    /* rhs[0] is left */
+    /* rhs[1] is operator */
+    /* rhs[2] is right */
+    node->left = rhs[0];
+    node->op = rhs[1]->type;
+    node->right = rhs[2];
 
     node->elided_type = rule->type;
     node->type = rule->type;
@@ -427,23 +428,21 @@ create_assignment_expression(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_declaration_specifiers(struct listnode *list, struct rule *rule)
+create_declaration_specifiers(struct astnode **rhs, struct rule *rule)
 {
     struct ast_declaration *node, *child;
 
     if (rule->length_of_nodes == 1)
     {
-        node = malloc(sizeof(struct ast_declaration));
-        memset(node, 0, sizeof(struct ast_declaration));
-        child = list_item(&list, 1);
+        node = arena_alloc(sizeof(struct ast_declaration));
+        child = (struct ast_declaration *)rhs[0];
     }
     else if (rule->length_of_nodes == 2)
     {
-        /* index 1 is AST_DECLARATION_SPECIFIERS astnode */
-        /* index 0 is AST_DECLARATION_SPECIFIERS state */
-        node = list_item(&list, 1);
+        /* rhs[1] is AST_DECLARATION_SPECIFIERS */
+        node = (struct ast_declaration *)rhs[1];
 
-        child = list_item(&list, 3);
+        child = (struct ast_declaration *)rhs[0];
     }
 
     switch (child->type)
@@ -477,7 +476,7 @@ create_declaration_specifiers(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_init_declarator_list(struct listnode *list, struct rule *rule)
+create_init_declarator_list(struct astnode **rhs, struct rule *rule)
 {
     struct ast_declaration *node, *init_declarator_list;
     struct ast_declarator *init_declarator;
@@ -487,31 +486,29 @@ create_init_declarator_list(struct listnode *list, struct rule *rule)
 
     if (is_rule(rule, AST_INIT_DECLARATOR))
     {
-        /* index 1 is AST_INIT_DECLARATOR astnode */
-        init_declarator = list_item(&list, 1);
+        /* rhs[0] is AST_INIT_DECLARATOR */
+        init_declarator = (struct ast_declarator *)rhs[0];
 
         node_size = sizeof(struct ast_declaration);
 
-        node = malloc(node_size);
-        memset(node, 0, node_size);
+        node = arena_alloc(node_size);
 
         node->declarators_size = 1;
         node->declarators[0] = init_declarator;
     }
     else if (is_rule(rule, AST_INIT_DECLARATOR_LIST, AST_COMMA, AST_INIT_DECLARATOR))
     {
-        /* index 5 is AST_INIT_DECLARATOR_LIST astnode */
-        /* index 3 is AST_COMMA astnode */
-        /* index 1 is AST_INIT_DECLARATOR astnode */
-        init_declarator_list = list_item(&list, 5);
-        init_declarator = list_item(&list, 1);
+        /* rhs[0] is AST_INIT_DECLARATOR_LIST */
+        /* rhs[1] is AST_COMMA */
+        /* rhs[2] is AST_INIT_DECLARATOR */
+        init_declarator_list = (struct ast_declaration *)rhs[0];
+        init_declarator = (struct ast_declarator *)rhs[2];
 
         node_size = sizeof(struct ast_declaration) +
                     sizeof(struct ast_declarator *) *
                     (init_declarator_list->declarators_size + 1);
 
-        node = malloc(node_size);
-        memset(node, 0, node_size);
+        node = arena_alloc(node_size);
 
         node->declarators_size = init_declarator_list->declarators_size + 1;
         memcpy(node->declarators, init_declarator_list->declarators,
@@ -524,7 +521,7 @@ create_init_declarator_list(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_init_declarator(struct listnode *list, struct rule *rule)
+create_init_declarator(struct astnode **rhs, struct rule *rule)
 {
     struct ast_declarator *node;
     assert(rule->length_of_nodes == 3);
@@ -532,23 +529,25 @@ create_init_declarator(struct listnode *list, struct rule *rule)
 
     if (is_rule(rule, AST_DECLARATOR, AST_EQUAL, AST_INITIALIZER))
     {
-        /* index 5 is AST_DECLARATOR astnode */
-        /* index 3 is AST_EQUAL astnode */
-        /* index 1 is AST_INITIALIZER astnode */
-        node = list_item(&list, 5);
-        node->initializer = list_item(&list, 1);
+        /* rhs[0] is AST_DECLARATOR */
+        /* rhs[1] is AST_EQUAL */
+        /* rhs[2] is AST_INITIALIZER */
+        node = (struct ast_declarator *)rhs[0];
+        node->initializer = (struct ast_initializer *)rhs[2];
     }
+
+    node->type = rule->type;
     return (struct astnode *)node;
 }
 
 struct astnode *
-create_declarator(struct listnode *list, struct rule *rule)
+create_declarator(struct astnode **rhs, struct rule *rule)
 {
     struct ast_declarator *node;
 
     if (is_rule(rule, AST_POINTER, AST_DIRECT_DECLARATOR))
     {
-        node = list_item(&list, 1);
+        node = (struct ast_declarator *)rhs[1];
         node->is_pointer = 1;
     }
 
@@ -557,25 +556,24 @@ create_declarator(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_direct_declarator(struct listnode *list, struct rule *rule)
+create_direct_declarator(struct astnode **rhs, struct rule *rule)
 {
     struct ast_declarator *node;
     struct astnode *child;
 
     if (is_rule(rule, AST_IDENTIFIER))
     {
-        /* index 1 is AST_IDENTIFIER astnode */
-        child = list_item(&list, 1);
+        /* rhs[0] is AST_IDENTIFIER */
+        child = rhs[0];
 
-        node = malloc(sizeof(struct ast_declarator));
-        memset(node, 0, sizeof(struct ast_declarator));
+        node = arena_alloc(sizeof(struct ast_declarator));
 
         node->declarator_identifier = child->token->value;
         node->count = NULL;
     }
     else if (rule->length_of_nodes == 3)
     {
-        node = list_item(&list, 5);
+        node = (struct ast_declarator *)rhs[0];
         if (node->type == AST_DIRECT_DECLARATOR)
         {
             /* { AST_DIRECT_DECLARATOR, AST_LBRACKET, AST_RBRACKET } */
@@ -584,26 +582,26 @@ create_direct_declarator(struct listnode *list, struct rule *rule)
         else
         {
             /* { AST_LPAREN, AST_DECLARATOR, AST_RPAREN } */
-            node = list_item(&list, 3);
+            node = (struct ast_declarator *)rhs[1];
         }
     }
     else if (is_rule(rule,
         AST_DIRECT_DECLARATOR, AST_LBRACKET, AST_CONSTANT_EXPRESSION, AST_RBRACKET))
     {
-        node = list_item(&list, 7);
+        node = (struct ast_declarator *)rhs[0];
 
         /*
          * FIXME: Not guaranteed this is a literal int. May have to evaluate
          * expression...
          */
-        node->count = (struct ast_expression *)list_item(&list, 3);
+        node->count = (struct ast_expression *)rhs[2];
     }
     else if (rule->length_of_nodes == 4)
     {
-        /* index 7 is AST_DIRECT_DECLARATOR astnode */
-        /* index 3 is AST_PARAMETER_TYPE_LIST | AST_IDENTIFIER_LIST astnode */
-        node = list_item(&list, 7);
-        child = list_item(&list, 3);
+        /* rhs[0] is AST_DIRECT_DECLARATOR */
+        /* rhs[2] is AST_PARAMETER_TYPE_LIST | AST_IDENTIFIER_LIST */
+        node = (struct ast_declarator *)rhs[0];
+        child = rhs[2];
 
         switch (child->type)
         {
@@ -636,27 +634,25 @@ create_direct_declarator(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_pointer(struct listnode *list, struct rule *rule)
+create_pointer(struct astnode **rhs, struct rule *rule)
 {
     struct astnode *node;
-    node = malloc(sizeof(struct astnode));
-    memset(node, 0, sizeof(struct astnode));
+    node = arena_alloc(sizeof(struct astnode));
 
     node->type = rule->type;
     return node;
 }
 
 struct astnode *
-create_storage_class_specifier(struct listnode *list, struct rule *rule)
+create_storage_class_specifier(struct astnode **rhs, struct rule *rule)
 {
     struct ast_declaration *node;
     struct astnode *child;
-    node = malloc(sizeof(struct ast_declaration));
-    memset(node, 0, sizeof(struct ast_declaration));
+    node = arena_alloc(sizeof(struct ast_declaration));
 
     assert(rule->length_of_nodes == 1);
 
-    child = list_item(&list, 1);
+    child = rhs[0];
     switch (child->type)
     {
         case AST_AUTO:
@@ -696,16 +692,15 @@ create_storage_class_specifier(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_type_specifier(struct listnode *list, struct rule *rule)
+create_type_specifier(struct astnode **rhs, struct rule *rule)
 {
     struct ast_declaration *node;
     struct astnode *child;
-    node = malloc(sizeof(struct ast_declaration));
-    memset(node, 0, sizeof(struct ast_declaration));
+    node = arena_alloc(sizeof(struct ast_declaration));
 
     assert(rule->length_of_nodes == 1);
 
-    child = list_item(&list, 1);
+    child = rhs[0];
     switch (child->type)
     {
         case AST_VOID:
@@ -780,16 +775,15 @@ create_type_specifier(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_type_qualifier(struct listnode *list, struct rule *rule)
+create_type_qualifier(struct astnode **rhs, struct rule *rule)
 {
     struct ast_declaration *node;
     struct astnode *child;
-    node = malloc(sizeof(struct ast_declaration));
-    memset(node, 0, sizeof(struct ast_declaration));
+    node = arena_alloc(sizeof(struct ast_declaration));
 
     assert(rule->length_of_nodes == 1);
 
-    child = list_item(&list, 1);
+    child = rhs[0];
     switch (child->type)
     {
         case AST_CONST:
@@ -814,29 +808,27 @@ create_type_qualifier(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_(struct listnode *list, struct rule *rule)
+create_(struct astnode **rhs, struct rule *rule)
 {
     struct astnode *node;
-    node = malloc(sizeof(struct astnode));
-    memset(node, 0, sizeof(struct astnode));
+    node = arena_alloc(sizeof(struct astnode));
 
     node->type = rule->type;
     return node;
 }
 
 struct astnode *
-create_binary_op(struct listnode *list, struct rule *rule)
+create_binary_op(struct astnode **rhs, struct rule *rule)
 {
     struct ast_binary_op *node;
-    node = malloc(sizeof(struct ast_binary_op));
-    memset(node, 0, sizeof(struct ast_binary_op));
+    node = arena_alloc(sizeof(struct ast_binary_op));
 
-    /* index 1 is right astnode */
-    /* index 3 is operator astnode */
-    /* index 5 is right astnode */
-    node->left = list_item(&list, 5);
-    node->op = ((struct astnode *)list_item(&list, 3))->type;
-    node->right = list_item(&list, 1);
+    /* rhs[0] is left */
+    /* rhs[1] is operator */
+    /* rhs[2] is right */
+    node->left = rhs[0];
+    node->op = rhs[1]->type;
+    node->right = rhs[2];
 
     node->elided_type = rule->type;
     node->type = rule->type;
@@ -844,28 +836,28 @@ create_binary_op(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_unary_expression(struct listnode *list, struct rule *rule)
+create_unary_expression(struct astnode **rhs, struct rule *rule)
 {
     struct ast_expression *node;
 
     if (is_rule(rule, AST_PLUS_PLUS, AST_UNARY_EXPRESSION))
     {
-        node = list_item(&list, 1);
+        node = (struct ast_expression *)rhs[1];
         node->inplace_op = PRE_INCREMENT;
     }
     else if (is_rule(rule, AST_MINUS_MINUS, AST_UNARY_EXPRESSION))
     {
-        node = list_item(&list, 1);
+        node = (struct ast_expression *)rhs[1];
         node->inplace_op = PRE_DECREMENT;
     }
     else if (is_rule(rule, AST_AMPERSAND, AST_CAST_EXPRESSION))
     {
-        node = list_item(&list, 1);
+        node = (struct ast_expression *)rhs[1];
         node->kind = PTR_VALUE;
     }
     else if (is_rule(rule, AST_ASTERISK, AST_CAST_EXPRESSION))
     {
-        node = list_item(&list, 1);
+        node = (struct ast_expression *)rhs[1];
         node->kind = PTR_VALUE;
     }
 
@@ -874,40 +866,40 @@ create_unary_expression(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_postfix_expression(struct listnode *list, struct rule *rule)
+create_postfix_expression(struct astnode **rhs, struct rule *rule)
 {
     struct ast_expression *node, *child;
 
     if (is_rule(rule, AST_POSTFIX_EXPRESSION, AST_LPAREN, AST_RPAREN))
     {
-        node = list_item(&list, 5);
+        node = (struct ast_expression *)rhs[0];
         node->kind = FUNCTION_VALUE;
     }
     else if (is_rule(rule,
         AST_POSTFIX_EXPRESSION, AST_LBRACKET, AST_EXPRESSION, AST_RBRACKET))
     {
-        node = list_item(&list, 7);
-        node->extra = list_item(&list, 3);
+        node = (struct ast_expression *)rhs[0];
+        node->extra = (struct ast_expression *)rhs[2];
     }
     else if (is_rule(rule,
         AST_POSTFIX_EXPRESSION, AST_LPAREN, AST_ARGUMENT_EXPRESSION_LIST, AST_RPAREN))
     {
-        /* index 7 is AST_POSTFIX_EXPRESSION astnode */
-        /* index 3 is AST_ARGUMENT_EXPRESSION_LIST astnode */
-        child = list_item(&list, 7);
-        node = list_item(&list, 3);
+        /* rhs[0] is AST_POSTFIX_EXPRESSION */
+        /* rhs[2] is AST_ARGUMENT_EXPRESSION_LIST */
+        child = (struct ast_expression *)rhs[0];
+        node = (struct ast_expression *)rhs[2];
 
         node->identifier = child->identifier;
         node->kind = FUNCTION_VALUE;
     }
     else if (is_rule(rule, AST_POSTFIX_EXPRESSION, AST_PLUS_PLUS))
     {
-        node = list_item(&list, 3);
+        node = (struct ast_expression *)rhs[0];
         node->inplace_op = POST_INCREMENT;
     }
     else if (is_rule(rule, AST_POSTFIX_EXPRESSION, AST_MINUS_MINUS))
     {
-        node = list_item(&list, 3);
+        node = (struct ast_expression *)rhs[0];
         node->inplace_op = POST_DECREMENT;
     }
 
@@ -916,32 +908,30 @@ create_postfix_expression(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_primary_expression(struct listnode *list, struct rule *rule)
+create_primary_expression(struct astnode **rhs, struct rule *rule)
 {
     struct ast_expression *node;
     struct astnode *child;
 
     if (is_rule(rule, AST_IDENTIFIER))
     {
-        node = malloc(sizeof(struct ast_expression));
-        memset(node, 0, sizeof(struct ast_expression));
+        node = arena_alloc(sizeof(struct ast_expression));
 
-        child = list_item(&list, 1);
+        child = rhs[0];
         node->identifier = child->token->value;
         node->kind = IDENTIFIER_VALUE;
     }
     else if (is_rule(rule, AST_STRING_CONSTANT))
     {
-        node = malloc(sizeof(struct ast_expression));
-        memset(node, 0, sizeof(struct ast_expression));
+        node = arena_alloc(sizeof(struct ast_expression));
 
-        child = list_item(&list, 1);
+        child = rhs[0];
         node->identifier = child->token->value;
         node->kind = STRING_VALUE;
     }
     else if (is_rule(rule, AST_LPAREN, AST_EXPRESSION, AST_RPAREN))
     {
-        node = list_item(&list, 3);
+        node = (struct ast_expression *)rhs[1];
     }
 
     node->type = rule->type;
@@ -949,7 +939,7 @@ create_primary_expression(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_argument_expression_list(struct listnode *list, struct rule *rule)
+create_argument_expression_list(struct astnode **rhs, struct rule *rule)
 {
     unsigned int node_size;
     struct ast_expression *node;
@@ -957,22 +947,22 @@ create_argument_expression_list(struct listnode *list, struct rule *rule)
     if (is_rule(rule, AST_ASSIGNMENT_EXPRESSION))
     {
         node_size = sizeof(struct ast_expression) + (sizeof(struct ast_expression *));
-        node = malloc(node_size);
-        memset(node, 0, node_size);
+        node = arena_alloc(node_size);
 
-        node->arguments[0] = list_item(&list, 1);
+        node->arguments[0] = (struct ast_expression *)rhs[0];
         node->arguments_size = 1;
     }
     else if (is_rule(rule,
              AST_ARGUMENT_EXPRESSION_LIST, AST_COMMA, AST_ASSIGNMENT_EXPRESSION))
     {
-        node = list_item(&list, 5);
+        node = (struct ast_expression *)rhs[0];
 
         node_size = sizeof(struct ast_expression) +
-            (sizeof(struct ast_expression *) * node->arguments_size + 1);
-        node = realloc(node, node_size);
+            (sizeof(struct ast_expression *) * node->arguments_size);
+        node = arena_realloc(node, node_size,
+                             node_size + sizeof(struct ast_expression *));
 
-        node->arguments[node->arguments_size] = list_item(&list, 1);
+        node->arguments[node->arguments_size] = (struct ast_expression *)rhs[2];
         node->arguments_size += 1;
     }
 
@@ -981,16 +971,15 @@ create_argument_expression_list(struct listnode *list, struct rule *rule)
 }
 
 struct astnode *
-create_constant(struct listnode *list, struct rule *rule)
+create_constant(struct astnode **rhs, struct rule *rule)
 {
     struct ast_expression *node;
     struct astnode *child;
-    node = malloc(sizeof(struct ast_expression));
-    memset(node, 0, sizeof(struct ast_expression));
+    node = arena_alloc(sizeof(struct ast_expression));
 
-    child = list_item(&list, 1);
+    child = rhs[0];
 
-    node->int_value = atoi(child->token->value);
+    node->int_value = child->token->int_value;
     node->type = rule->type;
     node->elided_type = rule->nodes[0];
     return (struct astnode *)node;
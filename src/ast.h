@@ -50,7 +50,7 @@ struct ast_expression
     enum astnode_t elided_type;
 
     int int_value;
-    char *identifier;
+    const char *identifier;
 
     /*
      * For indexes expressions, this holds the index value expression
@@ -142,7 +142,7 @@ struct ast_declarator
 
     int is_pointer;
 
-    char *declarator_identifier;
+    const char *declarator_identifier;
 
     /*TODO: remove declarator_value; it should be replaced by initializer*/
     int declarator_value;
@@ -256,96 +256,96 @@ struct astnode
 };
 
 struct astnode *
-create_translation_unit_node(struct listnode *list, struct rule *rule);
+create_translation_unit_node(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_elided_node(struct listnode *list, struct rule *rule);
+create_elided_node(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_function_definition(struct listnode *list, struct rule *rule);
+create_function_definition(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_declaration(struct listnode *list, struct rule *rule);
+create_declaration(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_declaration_list(struct listnode *list, struct rule *rule);
+create_declaration_list(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_parameter_list(struct listnode *list, struct rule *rule);
+create_parameter_list(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_parameter_declaration(struct listnode *list, struct rule *rule);
+create_parameter_declaration(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_initializer(struct listnode *list, struct rule *rule);
+create_initializer(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_expression_statement(struct listnode *list, struct rule *rule);
+create_expression_statement(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_compound_statement(struct listnode *list, struct rule *rule);
+create_compound_statement(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_statement_list(struct listnode *list, struct rule *rule);
+create_statement_list(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_selection_statement(struct listnode *list, struct rule *rule);
+create_selection_statement(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_iteration_statement(struct listnode *list, struct rule *rule);
+create_iteration_statement(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_jump_statement(struct listnode *list, struct rule *rule);
+create_jump_statement(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_assignment_expression(struct listnode *list, struct rule *rule);
+create_assignment_expression(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_declaration_specifiers(struct listnode *list, struct rule *rule);
+create_declaration_specifiers(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_init_declarator_list(struct listnode *list, struct rule *rule);
+create_init_declarator_list(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_init_declarator(struct listnode *list, struct rule *rule);
+create_init_declarator(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_declarator(struct listnode *list, struct rule *rule);
+create_declarator(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_direct_declarator(struct listnode *list, struct rule *rule);
+create_direct_declarator(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_pointer(struct listnode *list, struct rule *rule);
+create_pointer(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_storage_class_specifier(struct listnode *list, struct rule *rule);
+create_storage_class_specifier(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_type_specifier(struct listnode *list, struct rule *rule);
+create_type_specifier(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_type_qualifier(struct listnode *list, struct rule *rule);
+create_type_qualifier(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_(struct listnode *list, struct rule *rule);
+create_(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_binary_op(struct listnode *list, struct rule *rule);
+create_binary_op(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_unary_expression(struct listnode *list, struct rule *rule);
+create_unary_expression(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_postfix_expression(struct listnode *list, struct rule *rule);
+create_postfix_expression(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_primary_expression(struct listnode *list, struct rule *rule);
+create_primary_expression(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_argument_expression_list(struct listnode *list, struct rule *rule);
+create_argument_expression_list(struct astnode **rhs, struct rule *rule);
 
 struct astnode *
-create_constant(struct listnode *list, struct rule *rule);
+create_constant(struct astnode **rhs, struct rule *rule);
 
 #endif
@@ -21,7 +21,7 @@ static void visit_expression(struct astnode *ast,
                              struct ast_parameter_type_list *parameters,
                              struct ast_declaration_list *declarations);
 static void
-identifier_offset(char *identifier,
+identifier_offset(const char *identifier,
                   struct ast_parameter_type_list *parameters,
                   struct ast_declaration_list *declarations);
 
@@ -81,7 +81,7 @@ static int cursor = 0;
 static char string_literal_buffer[MAX_LITERAL_BUFFER_LEN];
 
 static char *
-create_string_literal(char *string)
+create_string_literal(const char *string)
 {
     static int i = 0;
     int j;
@@ -122,7 +122,10 @@ write_assembly(char *format, ...)
 }
 
 int globals_index = 0;
-char *globals[256];
+/*
+ * Identifiers are interned by the scanner, so names are compared by pointer.
+ */
+const char *globals[256];
 
 static void
 visit_declaration(struct ast_declaration *ast, enum scope scope)
@@ -329,7 +332,7 @@ visit_identifier(struct ast_expression *ast,
     {
         parameter = parameters->items[i];
 
-        if (strcmp(ast->identifier, parameter->declarators[0]->declarator_identifier) == 0)
+        if (ast->identifier == parameter->declarators[0]->declarator_identifier)
         {
             identifier_offset(ast->identifier, parameters, declarations);
             write_assembly("  mov (%%rbx), %%eax");
@@ -339,9 +342,8 @@ visit_identifier(struct ast_expression *ast,
 
     for (i=0; declarations && i<declarations->size; i++)
     {
-        if (strcmp(ast->identifier,
-                   declarations->items[i]->declarators[0]->declarator_identifier)
-            != 0)
+        if (ast->identifier !=
+            declarations->items[i]->declarators[0]->declarator_identifier)
         {
             continue;
         }
@@ -376,7 +378,7 @@ visit_identifier(struct ast_expression *ast,
 
     for (i=0; i<globals_index; i++)
     {
-        if (strcmp(ast->identifier, globals[i]) == 0)
+        if (ast->identifier == globals[i])
         {
             write_assembly("  movl _%s(%%rip), %%eax", ast->identifier);
             goto done;
@@ -537,7 +539,7 @@ visit_equality_expression(struct ast_binary_op *ast,
 }
 
 static void
-identifier_offset(char *identifier,
+identifier_offset(const char *identifier,
                   struct ast_parameter_type_list *parameters,
                   struct ast_declaration_list *declarations)
 {
@@ -581,8 +583,7 @@ identifier_offset(char *identifier,
 
         write_assembly("  add $%d, %%rcx",
                        align8(size_of_type(parameter->type_specifiers)));
-        if (strcmp(identifier,
-                   parameter->declarators[0]->declarator_identifier) == 0)
+        if (identifier == parameter->declarators[0]->declarator_identifier)
         {
             goto end;
         }
@@ -612,8 +613,7 @@ identifier_offset(char *identifier,
             }
         }
 
-        if (strcmp(identifier,
-                   declaration->declarators[0]->declarator_identifier) == 0)
+        if (identifier == declaration->declarators[0]->declarator_identifier)
         {
             goto end;
         }
@@ -1018,8 +1018,17 @@ visit_translation_unit(struct ast_translation_unit *ast)
 void
 generate(struct astnode *ast, char *outfile)
 {
+    /*
+     * String literals and globals of a previously generated file must not
+     * leak into this one.
+     */
+    cursor = 0;
+    string_literal_buffer[0] = '\0';
+    globals_index = 0;
+
     assembly_filename = fopen(outfile, "w");
     visit_translation_unit((struct ast_translation_unit *)ast);
 
     write_assembly(string_literal_buffer);
+    fclose(assembly_filename);
 }
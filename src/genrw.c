@@ -0,0 +1,194 @@
+/*
+ * Generates reservedwords.h, the perfect hash table of reserved words used by
+ * the scanner. A reserved word hashes to
+ *
+ *     (length + values[first character] + values[last character]) % SIZE
+ *
+ * and values is searched for (in the manner of gperf) so that no two reserved
+ * words share a slot. To add a reserved word, add it to reserved_words below
+ * along with its token.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RESERVED_WORDS_SIZE 64
+#define MAX_ATTEMPTS 1000000
+
+struct reserved_word
+{
+    const char *name;
+    const char *token;
+};
+
+static const struct reserved_word reserved_words[] =
+{
+    { "auto", "TOK_AUTO" },
+    { "break", "TOK_BREAK" },
+    { "case", "TOK_CASE" },
+    { "char", "TOK_CHAR" },
+    { "const", "TOK_CONST" },
+    { "continue", "TOK_CONTINUE" },
+    { "default", "TOK_DEFAULT" },
+    { "do", "TOK_DO" },
+    { "double", "TOK_DOUBLE" },
+    { "else", "TOK_ELSE" },
+    { "enum", "TOK_ENUM" },
+    { "extern", "TOK_EXTERN" },
+    { "float", "TOK_FLOAT" },
+    { "for", "TOK_FOR" },
+    { "goto", "TOK_GOTO" },
+    { "if", "TOK_IF" },
+    { "int", "TOK_INT" },
+    { "long", "TOK_LONG" },
+    { "register", "TOK_REGISTER" },
+    { "return", "TOK_RETURN" },
+    { "short", "TOK_SHORT" },
+    { "signed", "TOK_SIGNED" },
+    { "static", "TOK_STATIC" },
+    { "struct", "TOK_STRUCT" },
+    { "switch", "TOK_SWITCH" },
+    { "typedef", "TOK_TYPEDEF" },
+    { "union", "TOK_UNION" },
+    { "unsigned", "TOK_UNSIGNED" },
+    { "void", "TOK_VOID" },
+    { "volatile", "TOK_VOLATILE" },
+    { "while", "TOK_WHILE" },
+};
+
+#define NUM_RESERVED_WORDS \
+    ((int)(sizeof(reserved_words) / sizeof(reserved_words[0])))
+
+static unsigned char values[128];
+static int slots[RESERVED_WORDS_SIZE];
+
+/*
+ * A small linear congruential generator, so that the table generated is the
+ * same on every platform.
+ */
+static unsigned long long random_state = 1;
+
+static unsigned int
+next_random(void)
+{
+    random_state = random_state * 6364136223846793005ULL +
+                   1442695040888963407ULL;
+    return (unsigned int)(random_state >> 33);
+}
+
+static unsigned int
+hash(const char *name)
+{
+    size_t length = strlen(name);
+
+    return (length + values[name[0] & 0x7f] + values[name[length - 1] & 0x7f]) &
+           (RESERVED_WORDS_SIZE - 1);
+}
+
+/*
+ * Give the first and last characters of the reserved words random values and
+ * fill slots with the index of the reserved word in each. Returns 0 if two
+ * reserved words share a slot.
+ */
+static int
+try_values(void)
+{
+    const char *name;
+    unsigned int slot;
+    int i;
+
+    memset(values, 0, sizeof(values));
+    for (i=0; i<NUM_RESERVED_WORDS; i++)
+    {
+        name = reserved_words[i].name;
+        values[name[0] & 0x7f] = next_random() % RESERVED_WORDS_SIZE;
+        values[name[strlen(name) - 1] & 0x7f] =
+            next_random() % RESERVED_WORDS_SIZE;
+    }
+
+    memset(slots, 0xff, sizeof(slots));
+    for (i=0; i<NUM_RESERVED_WORDS; i++)
+    {
+        slot = hash(reserved_words[i].name);
+        if (slots[slot] != -1)
+        {
+            return 0;
+        }
+        slots[slot] = i;
+    }
+
+    return 1;
+}
+
+int
+main(void)
+{
+    size_t length, min_length = 0, max_length = 0;
+    int attempt, i;
+    FILE *fp;
+
+    assert(NUM_RESERVED_WORDS <= RESERVED_WORDS_SIZE);
+
+    for (attempt=0; attempt<MAX_ATTEMPTS && !try_values(); attempt++)
+    {
+    }
+    if (attempt == MAX_ATTEMPTS)
+    {
+        fprintf(stderr, "No perfect hash of the reserved words found\n");
+        return 1;
+    }
+
+    for (i=0; i<NUM_RESERVED_WORDS; i++)
+    {
+        length = strlen(reserved_words[i].name);
+        if (min_length == 0 || length < min_length)
+        {
+            min_length = length;
+        }
+        if (length > max_length)
+        {
+            max_length = length;
+        }
+    }
+
+    fp = fopen("reservedwords.h", "w");
+    assert(fp != NULL);
+
+    fprintf(fp, "/* Generated by genrw. Do not edit. */\n\n");
+    fprintf(fp, "#define RESERVED_WORDS_SIZE %d\n", RESERVED_WORDS_SIZE);
+    fprintf(fp, "#define MIN_RESERVED_WORD_LENGTH %zu\n", min_length);
+    fprintf(fp, "#define MAX_RESERVED_WORD_LENGTH %zu\n\n", max_length);
+
+    fprintf(fp, "static const unsigned char reserved_word_values[128] =\n{");
+    for (i=0; i<128; i++)
+    {
+        fprintf(fp, "%s%2d,", i % 16 == 0 ? "\n    " : " ", values[i]);
+    }
+    fprintf(fp, "\n};\n\n");
+
+    fprintf(fp, "static const struct reserved_word "
+            "reserved_words[RESERVED_WORDS_SIZE] =\n{\n");
+    for (i=0; i<RESERVED_WORDS_SIZE; i++)
+    {
+        if (slots[i] == -1)
+        {
+            fprintf(fp, "    { \"\", 0, TOK_EOF },\n");
+        }
+        else
+        {
+            fprintf(fp, "    { \"%s\", %zu, %s },\n",
+                    reserved_words[slots[i]].name,
+                    strlen(reserved_words[slots[i]].name),
+                    reserved_words[slots[i]].token);
+        }
+    }
+    fprintf(fp, "};\n");
+
+    fclose(fp);
+    printf("Reserved words: %d, after %d attempts\n", NUM_RESERVED_WORDS,
+           attempt + 1);
+
+    return 0;
+}
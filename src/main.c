@@ -1,30 +1,82 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#endif
 
 #include "scanner.h"
+#include "preprocessor.h"
 #include "parser.h"
 #include "generator.h"
 
-static char *
-read_file(const char *filename, long *filelength)
+/*
+ * Find the path of the running clink executable: from /proc/self/exe on
+ * Linux, _NSGetExecutablePath() on Darwin and otherwise from argv[0] when it
+ * names a path rather than a command found on PATH. Returns 0 on success or -1
+ * if there is no telling.
+ */
+static int
+executable_path(char *path, size_t size, const char *argv0)
 {
-    FILE *f;
-    long length;
-    char *buffer;
-
-    f = fopen(filename, "r");
-    fseek(f, 0, SEEK_END);
-    length = ftell(f);
-    fseek(f, 0, SEEK_SET);
-    buffer = malloc(length);
-    if (buffer)
+    ssize_t length;
+#ifdef __APPLE__
+    uint32_t buffer_size = size;
+
+    if (_NSGetExecutablePath(path, &buffer_size) == 0)
+    {
+        return 0;
+    }
+#endif
+
+    length = readlink("/proc/self/exe", path, size - 1);
+    if (length >= 0)
+    {
+        path[length] = '\0';
+        return 0;
+    }
+
+    if (strchr(argv0, '/') != NULL && strlen(argv0) < size)
     {
-        fread(buffer, 1, length, f);
+        strcpy(path, argv0);
+        return 0;
     }
-    fclose(f);
-    *filelength = length;
-    return buffer;
+
+    return -1;
+}
+
+/*
+ * Use the parse table file named by CLINK_PARSETABLE, or the one genpt wrote
+ * next to the clink executable, so that it doesn't depend on the directory
+ * clink is run from. The tables compiled into clink are used if neither can
+ * be loaded.
+ */
+static void
+load_parsetable_file(const char *argv0)
+{
+    char path[4096];
+    const char *filename = getenv("CLINK_PARSETABLE");
+    char *slash;
+
+    if (filename == NULL)
+    {
+        if (executable_path(path, sizeof(path), argv0) < 0)
+        {
+            return;
+        }
+
+        slash = strrchr(path, '/');
+        if (slash == NULL)
+        {
+            return;
+        }
+        snprintf(slash + 1, sizeof(path) - (slash + 1 - path), "%s",
+                 PARSETABLE_FILENAME);
+        filename = path;
+    }
+
+    load_parsetable(filename);
 }
 
 char *
@@ -37,27 +89,59 @@ assembly_filename(char *filename)
 int
 main(int argc, char *argv[])
 {
-    int total_tokens;
-    struct listnode *tokens = NULL;
+    struct preprocessor preprocessor;
     struct astnode *ast;
 
     char filename[25];
-    char *buffer;
-    long filelength;
+    struct source source;
+    int i;
 
     if (argc < 2)
     {
-        printf("Not enough args. Must provide a file to compile.");
+        printf("Not enough args. Must provide a file to compile.\n"
+               "usage: %s [-Idir]... file.c...\n"
+               "Headers are only looked for in the -I directories (and, for "
+               "#include \"...\",\nin the directory of the including file). "
+               "There are no system include\ndirectories: a header included "
+               "with <...> that isn't found is skipped.\n", argv[0]);
         return 1;
     }
-    strncpy(filename, argv[1], sizeof(filename));
 
-    buffer = read_file(filename, &filelength);
-    //preprocess("test.c", "_test.c");
-    scan(buffer, filelength, &tokens);
-    ast = parse(tokens);
+    load_parsetable_file(argv[0]);
+
+    for (i=1; i<argc; i++)
+    {
+        if (strncmp(argv[i], "-I", 2) == 0)
+        {
+            add_include_directory(argv[i] + 2);
+            continue;
+        }
 
-    generate(ast, assembly_filename(filename));
+        strncpy(filename, argv[i], sizeof(filename));
+
+        if (!open_source(filename, &source))
+        {
+            printf("Can't open %s\n", filename);
+            return 1;
+        }
+
+        preprocessor_init(&preprocessor, filename, source.content,
+                          source.length);
+        ast = parse(&preprocessor);
+        if (ast == NULL)
+        {
+            return 1;
+        }
+
+        generate(ast, assembly_filename(filename));
+
+        /*
+         * Strings, headers and the AST of the file are no longer needed.
+         */
+        release_headers();
+        arena_release();
+        close_source(&source);
+    }
 
     return 0;
 }
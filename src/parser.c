@@ -2,7 +2,8 @@
  * Provides a bottom-up CLR(1) parser. This involves 3 main steps:
  *
  * 1) Given a grammar, construct a state machine. This performed in
- *    `generate_states()`.
+ *    `generate_states()`. States with identical cores may then be merged
+ *    into LALR(1) states by `merge_states()`.
  * 2) Given a state machine, construct a parse table. This is performed in
  *    `init_parsetable()`.
  * 3) Given a parse table, construct the AST (abstract syntax tree). This is
@@ -10,32 +11,87 @@
  */
 
 #include <assert.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "grammar.h"
 #include "parser.h"
 #include "utilities.h"
 
 #ifdef GENPT
+#include <pthread.h>
+
 static struct parsetable_item *parsetable = NULL;
 #else
 #include "parsetable.h"
+
+/*
+ * parsetable points at the tables compiled in from parsetable.h unless
+ * load_parsetable() has mapped a parse table file, which is kept in
+ * parsetable_map.
+ */
+static const struct packed_parsetable compiled_parsetable =
+{
+    PARSETABLE_STATES,
+    PARSETABLE_ELIDED,
+    parsetable_action_default,
+    parsetable_action_base,
+    parsetable_action_check,
+    parsetable_action_value,
+    parsetable_goto_default,
+    parsetable_goto_base,
+    parsetable_goto_check,
+    parsetable_goto_value
+};
+
+static const struct packed_parsetable *parsetable = &compiled_parsetable;
+static struct packed_parsetable mapped_parsetable;
+static void *parsetable_map = NULL;
+static size_t parsetable_map_size = 0;
 #endif
 
 /*
  * state_identifier indicates the total number of states in the grammar.
  */
 static int state_identifier = 0;
-static int tmp_state_identifier = 0;
 
 /*
- * states is the list of states in the grammar.
+ * states maps state identifiers to the states of the grammar. States are
+ * numbered in the order they are found, so states also serves as the worklist
+ * of generate_states(). It grows as states are added, and the states
+ * themselves are allocated from state_pool so that links to them stay valid.
+ */
+static struct state **states = NULL;
+static int states_capacity = 0;
+
+static struct state *state_pool = NULL;
+static int state_pool_used = STATE_POOL_BLOCK_SIZE;
+
+/*
+ * state_table is an open addressing hash table that maps state fingerprints to
+ * indexes in global states. Slots hold the index plus one so that zero marks
+ * an empty slot. It is doubled whenever it becomes half full.
+ */
+static int *state_table = NULL;
+static unsigned long state_table_size = 0;
+
+/*
+ * first_sets holds the terminals that can begin each symbol and nullable holds
+ * whether each symbol can derive the empty string. Both are computed once from
+ * the grammar by init_first_sets().
  */
-static struct state states[MAX_STATES];
+static struct lookahead first_sets[NUM_SYMBOLS];
+static char nullable[NUM_SYMBOLS];
+static int first_sets_initialized = 0;
 
-static struct state temp_states[MAX_STATES];
+#define FNV_OFFSET_BASIS 14695981039346656037UL
+#define FNV_PRIME 1099511628211UL
 
 /*
  * Print a state in the parser state machine.
@@ -43,1039 +99,2641 @@ static struct state temp_states[MAX_STATES];
 void
 print_state(struct state *s)
 {
-    struct listnode *items, *lookaheads;
-    struct item *item;
-    int i;
+    int i, j;
 
     printf("state %d\n", s->identifier);
-    for (items=s->items; items!=NULL; items=items->next)
+    for (i=0; i<s->kernel.size; i++)
     {
-        item = (struct item *)items->data;
-        printf("  (%d,%d)", (int)(item->rewrite_rule-grammar), item->cursor_position);
+        printf("  (%d,%d)", (int)(core_rule(s->kernel.cores[i]) - grammar),
+               core_position(s->kernel.cores[i]));
 
-        for (lookaheads=item->lookahead; lookaheads!=NULL; lookaheads=lookaheads->next)
+        for (j=0; j<NUM_TERMINALS; j++)
         {
-            printf(" %d", (int)(lookaheads->data));
+            if (lookahead_contains(&s->kernel.lookaheads[i], j))
+            {
+                printf(" %d", j);
+            }
         }
         printf("\n");
     }
 }
 
-static int
-checked_nodes_contains(struct listnode **items, enum astnode_t node)
+void
+lookahead_add(struct lookahead *lookahead, enum astnode_t terminal)
 {
-    int contains = 0;
-    struct listnode *c;
-
-    c = *items;
-    while (c != NULL)
-    {
-        if ((enum astnode_t)c->data == node)
-        {
-            contains = 1;
-            break;
-        }
+    lookahead->words[terminal / LOOKAHEAD_WORD_BITS] |=
+        1ULL << (terminal % LOOKAHEAD_WORD_BITS);
+}
 
-        c = c->next;
-    }
-    return contains;
+int
+lookahead_contains(const struct lookahead *lookahead, enum astnode_t terminal)
+{
+    return (lookahead->words[terminal / LOOKAHEAD_WORD_BITS] >>
+            (terminal % LOOKAHEAD_WORD_BITS)) & 1;
 }
 
 void
-head_terminal_values(enum astnode_t node, struct listnode **checked_nodes,
-                     struct listnode **terminals)
+lookahead_union(struct lookahead *a, const struct lookahead *b)
 {
     int i;
 
-    if (checked_nodes_contains(checked_nodes, node))
+    for (i=0; i<LOOKAHEAD_WORDS; i++)
     {
-        /*
-         * If another iteration is already checking node, then there is nothing
-         * more to do here.
-         */
-        return;
+        a->words[i] |= b->words[i];
     }
+}
+
+int
+lookahead_equal(const struct lookahead *a, const struct lookahead *b)
+{
+    int i;
 
-    if (node < AST_INVALID)
+    for (i=0; i<LOOKAHEAD_WORDS; i++)
     {
-        /*
-         * If node is a terminal symbol then add it and return.
-         */
-        list_append(terminals, (void *)node);
-        return;
+        if (a->words[i] != b->words[i])
+        {
+            return 0;
+        }
     }
+    return 1;
+}
 
-    /*
-     * Update checked_nodes to avoid trying to repeated work and infinite
-     * recursion.
-     */
-    list_append(checked_nodes, (void *)node);
+/*
+ * Initialize the FIRST set and nullable flag of every symbol. Terminals begin
+ * with themselves and rules are applied repeatedly until no set changes.
+ */
+static void
+init_first_sets(void)
+{
+    int i, j, lhs, rhs, changed;
+    struct lookahead before;
 
-    for (i=0; i<NUM_RULES; i++)
+    for (i=0; i<NUM_TERMINALS; i++)
+    {
+        lookahead_add(&first_sets[i], i);
+    }
+
+    do
     {
-        if (grammar[i].type == node)
+        changed = 0;
+
+        for (i=0; i<NUM_RULES; i++)
         {
-            if (grammar[i].nodes[0] < AST_INVALID &&
-                !checked_nodes_contains(terminals, grammar[i].nodes[0]))
+            lhs = INDEX(grammar[i].type);
+            before = first_sets[lhs];
+
+            for (j=0; j<grammar[i].length_of_nodes; j++)
             {
-                /*
-                 * If the symbol is a terminal value and we have not already
-                 * added it to terminals then add it
-                 */
-                list_append(terminals, (void *)grammar[i].nodes[0]);
+                rhs = INDEX(grammar[i].nodes[j]);
+                lookahead_union(&first_sets[lhs], &first_sets[rhs]);
+
+                if (!nullable[rhs])
+                {
+                    break;
+                }
             }
-            else if (grammar[i].nodes[0] != node)
+
+            if (j == grammar[i].length_of_nodes && !nullable[lhs])
             {
                 /*
-                 * If the symbol is a non-terminal value then recurse and find
-                 * the head terminal
+                 * Every symbol in the rule can derive the empty string.
                  */
-                head_terminal_values(grammar[i].nodes[0], checked_nodes,
-                                     terminals);
+                nullable[lhs] = 1;
+                changed = 1;
+            }
+
+            if (!lookahead_equal(&before, &first_sets[lhs]))
+            {
+                changed = 1;
             }
         }
-    }
+    } while (changed);
+
+    first_sets_initialized = 1;
 }
 
-static int
-items_contains(struct listnode **items, struct rule *r, int position, struct listnode *lookahead)
+/*
+ * Returns the set of terminals that can begin the given symbol.
+ */
+const struct lookahead *
+first_set(enum astnode_t node)
 {
-    int contains = 0;
-    struct listnode *c;
-    struct item *i;
-
-    c = *items;
-    while (c != NULL)
+    if (!first_sets_initialized)
     {
-        i = (struct item *)c->data;
-        if (i->rewrite_rule == r && i->cursor_position == position &&
-            list_equal(i->lookahead, lookahead))
-        {
-            contains = 1;
-            break;
-        }
+        init_first_sets();
+    }
+
+    return &first_sets[INDEX(node)];
+}
 
-        c = c->next;
+/*
+ * Returns whether the given symbol can derive the empty string.
+ */
+int
+symbol_nullable(enum astnode_t node)
+{
+    if (!first_sets_initialized)
+    {
+        init_first_sets();
     }
-    return contains;
+
+    return nullable[INDEX(node)];
 }
 
 /*
- * Generate the items for a given production node.
+ * Find the terminals that can begin the sequence of symbols nodes followed by
+ * follow. Follow is only included if the entire sequence is nullable.
  */
 void
-generate_items(enum astnode_t node, struct listnode *lookahead, struct listnode **items)
+first_of_sequence(const enum astnode_t *nodes, int length,
+                  const struct lookahead *follow, struct lookahead *terminals)
 {
     int i;
-    struct item *item;
-    struct listnode *checked_nodes, *next_lookahead;
 
-    for (i=0; i<NUM_RULES; i++)
+    memset(terminals, 0, sizeof(struct lookahead));
+
+    for (i=0; i<length; i++)
     {
-        if (grammar[i].type == node && !items_contains(items, &grammar[i], 0, lookahead))
+        lookahead_union(terminals, first_set(nodes[i]));
+
+        if (!symbol_nullable(nodes[i]))
         {
-            item = malloc(sizeof(struct item));
-            item->rewrite_rule = &grammar[i];
-            item->cursor_position = 0;
-            item->lookahead = lookahead;
+            return;
+        }
+    }
 
-            list_append(items, item);
+    lookahead_union(terminals, follow);
+}
 
-            /*
-             * Recurse if the derivation begins with variable.
-             */
-            if (grammar[i].nodes[0] > AST_INVALID)
-            {
-                if (grammar[i].length_of_nodes > 1)
-                {
-                    list_init(&checked_nodes);
-                    list_init(&next_lookahead);
-
-                    head_terminal_values(
-                        grammar[i].nodes[1],
-                        &checked_nodes,
-                        &next_lookahead);
-                    generate_items(grammar[i].nodes[0], next_lookahead, items);
-                }
-                else
-                {
-                    generate_items(grammar[i].nodes[0], lookahead, items);
-                }
-            }
+/*
+ * Item cores, a rule and a cursor position without lookahead, are interned as
+ * dense integers. The cores of a rule are numbered consecutively from its
+ * core_offsets entry, one for each cursor position, and core_rules and
+ * core_positions map them back. They are initialized once by init_cores().
+ */
+static int core_offsets[NUM_RULES];
+static int core_rules[MAX_CORES];
+static int core_positions[MAX_CORES];
+static int cores_size = 0;
+
+static void
+init_cores(void)
+{
+    int i, j;
+
+    for (i=0; i<NUM_RULES; i++)
+    {
+        core_offsets[i] = cores_size;
+
+        for (j=0; j<=grammar[i].length_of_nodes; j++)
+        {
+            core_rules[cores_size] = i;
+            core_positions[cores_size] = j;
+            cores_size++;
         }
     }
 }
 
 /*
- * Generate a state with items, recursively construct connecting states and
- * transitions.
+ * Returns the core of a rule with the given cursor position.
  */
-void
-generate_transitions(struct state *s)
+int
+item_core(struct rule *rule, int cursor_position)
 {
-    struct listnode *items;
-    struct item *i, *j;
-    struct rule *r;
-    int index, new_index;
+    if (cores_size == 0)
+    {
+        init_cores();
+    }
 
+    return core_offsets[rule - grammar] + cursor_position;
+}
 
-    for (items=s->items; items!=NULL; items=items->next)
+/*
+ * Returns the rule of a core, or NULL if there is no such core.
+ */
+struct rule *
+core_rule(int core)
+{
+    if (cores_size == 0)
     {
-        i = (struct item *)items->data;
-        r = i->rewrite_rule;
+        init_cores();
+    }
 
-        /*
-         * Check if the item contains another consumable value.
-         */
-        if (i->cursor_position < r->length_of_nodes)
-        {
-            j = malloc(sizeof(struct item));
-            j->rewrite_rule = i->rewrite_rule;
+    if (core < 0 || core >= cores_size)
+    {
+        return NULL;
+    }
 
-            j->lookahead = i->lookahead;
-            j->cursor_position = i->cursor_position + 1;
+    return &grammar[core_rules[core]];
+}
 
-            index = INDEX(i->rewrite_rule->nodes[i->cursor_position]);
-            if (s->links[index] == NULL)
-            {
-                assert(tmp_state_identifier < MAX_STATES);
+/*
+ * Returns the cursor position of a core.
+ */
+int
+core_position(int core)
+{
+    if (cores_size == 0)
+    {
+        init_cores();
+    }
 
-                s->links[index] = &temp_states[tmp_state_identifier++];
-                memset(s->links[index], 0, sizeof(struct state));
-            }
+    return core_positions[core];
+}
 
-            if (items_contains(&s->links[index]->items, j->rewrite_rule,
-                                j->cursor_position, j->lookahead))
-            {
-                /*
-                 * If state already contains item then continue.
-                 */
-                free(j);
-                continue;
-            }
+/*
+ * Allocate room for the given number of kernel items. The cores share the
+ * block of the lookaheads, so freeing the lookaheads frees both.
+ */
+static void
+kernel_alloc(struct kernel *kernel, int size)
+{
+    kernel->size = size;
+    kernel->lookaheads = malloc((sizeof(struct lookahead) + sizeof(int)) * size);
+    assert(kernel->lookaheads != NULL || size == 0);
+    kernel->cores = (int *)(kernel->lookaheads + size);
+}
 
-            list_append(&s->links[index]->items, j);
+/*
+ * Add a nonterminal with a lookahead to a closure, along with the nonterminals
+ * that begin its rules. A nonterminal already in the closure is only followed
+ * again when its lookahead grows.
+ */
+void
+generate_closure(enum astnode_t node, const struct lookahead *lookahead,
+                 struct closure *closure)
+{
+    int i;
+    struct lookahead before, next_lookahead;
+    struct lookahead *node_lookahead;
 
-            if (j->cursor_position < j->rewrite_rule->length_of_nodes &&
-                j->rewrite_rule->nodes[j->cursor_position] > AST_INVALID)
-            {
-                /*
-                 * Append new states due to subsequent non-terminal.
-                 */
-                struct listnode *lookahead;
-                list_init(&lookahead);
+    node_lookahead = &closure->lookaheads[INDEX(node)];
+    before = *node_lookahead;
+    lookahead_union(node_lookahead, lookahead);
 
-                if (j->cursor_position + 1 < j->rewrite_rule->length_of_nodes)
-                {
-                    /*
-                     * If a follow symbol exists then find terminal values of
-                     * the follow symbol. Then generate items derived from the
-                     * current symbol and add them to state with the new
-                     * lookahead.
-                     */
-                    struct listnode *checked_nodes;
-                    list_init(&checked_nodes);
-
-                    head_terminal_values(
-                        j->rewrite_rule->nodes[j->cursor_position + 1],
-                        &checked_nodes,
-                        &lookahead);
-
-                    generate_items(
-                        j->rewrite_rule->nodes[j->cursor_position],
-                        lookahead, &s->links[index]->items);
-                }
-                else
-                {
-                    /*
-                     * If there is no follow symbol then simply generate the
-                     * items derived fromthe current symbol and pass along the
-                     * current lookahead from the previous state.
-                     */
-                    generate_items(
-                        j->rewrite_rule->nodes[j->cursor_position],
-                        j->lookahead, &s->links[index]->items);
-                }
+    if (closure->contains[INDEX(node)] &&
+        lookahead_equal(&before, node_lookahead))
+    {
+        return;
+    }
+    closure->contains[INDEX(node)] = 1;
 
-            }
+    for (i=0; i<NUM_RULES; i++)
+    {
+        /*
+         * Recurse if the derivation begins with variable. Its items are
+         * followed by whatever can begin the rest of the rule.
+         */
+        if (grammar[i].type == node && grammar[i].length_of_nodes > 0 &&
+            grammar[i].nodes[0] > AST_INVALID)
+        {
+            first_of_sequence(
+                &grammar[i].nodes[1],
+                grammar[i].length_of_nodes - 1,
+                node_lookahead,
+                &next_lookahead);
+            generate_closure(grammar[i].nodes[0], &next_lookahead, closure);
         }
     }
+}
 
-    for (index=0; index<NUM_SYMBOLS; index++)
-    {
-        new_index = index_of_state(s->links[index]);
+/*
+ * Compute the closure of a kernel. Items derived from the symbol after the
+ * cursor of a kernel item are followed by the terminals that can begin the
+ * rest of its rule, or by its lookahead when the rest of the rule is nullable.
+ */
+void
+kernel_closure(struct kernel *kernel, struct closure *closure)
+{
+    int i, position;
+    struct rule *rule;
+    struct lookahead lookahead;
 
-        if (s->links[index] != NULL && new_index == -1)
-        {
-            /*
-             * If the state does not exist in global states then update the
-             * links and recursively generate next transitions. We waited until
-             * now to set the link because we finally know all items have been
-             * added and can avoid duplicate states.
-             */
-            new_index = state_identifier++;
-            assert(state_identifier < MAX_STATES);
+    memset(closure, 0, sizeof(struct closure));
 
-            s->links[index]->identifier = new_index;
-            states[new_index] = *s->links[index];
+    for (i=0; i<kernel->size; i++)
+    {
+        rule = core_rule(kernel->cores[i]);
+        position = core_position(kernel->cores[i]);
 
-            generate_transitions(&states[new_index]);
-        }
-        else if (s->links[index] != NULL)
+        if (position < rule->length_of_nodes &&
+            rule->nodes[position] > AST_INVALID)
         {
-            /*
-             * It may be the case that state was recursively generated. In
-             * which case we do not want to recurse again, but we still need to
-             * set the identifier.
-             */
-            s->links[index]->identifier = new_index;
+            first_of_sequence(
+                &rule->nodes[position + 1],
+                rule->length_of_nodes - position - 1,
+                &kernel->lookaheads[i],
+                &lookahead);
+            generate_closure(rule->nodes[position], &lookahead, closure);
         }
     }
 }
 
+static void
+insert_state(int index);
+
 /*
- * Generates all state for grammar and returns the root state.
+ * Add a state with a kernel that is not yet in global states. The state takes
+ * over the kernel items, is given the next identifier and is processed by
+ * generate_states() after every state found before it.
  */
-struct state *
-generate_states(void)
+static struct state *
+add_state(struct kernel *kernel)
 {
     struct state *s;
 
-    memset(states, 0, sizeof(struct state) * MAX_STATES);
+    if (state_pool_used == STATE_POOL_BLOCK_SIZE)
+    {
+        state_pool = calloc(STATE_POOL_BLOCK_SIZE, sizeof(struct state));
+        assert(state_pool != NULL);
+        state_pool_used = 0;
+    }
+
+    if (state_identifier == states_capacity)
+    {
+        states_capacity = states_capacity ? states_capacity * 2 :
+                          STATE_POOL_BLOCK_SIZE;
+        states = realloc(states, sizeof(struct state *) * states_capacity);
+        assert(states != NULL);
+    }
 
-    s = &states[0];
+    s = &state_pool[state_pool_used++];
     s->identifier = state_identifier++;
+    s->kernel = *kernel;
 
-    generate_items(AST_TRANSLATION_UNIT, NULL, &s->items);
-    generate_transitions(s);
+    states[s->identifier] = s;
+    insert_state(s->identifier);
 
     return s;
 }
 
+static int
+lookup_state(struct kernel *kernel);
+
 /*
- * Returns whether the given state contains the given item.
+ * transitions holds the successors of a state while its transitions are being
+ * generated. kernels are the items reached by each symbol, empty when there is
+ * no transition, and index is the global state with an identical kernel, or -1
+ * if none was found.
  */
-int
-state_contains_item(struct state *state, struct item *item)
+struct transitions
 {
-    int contains = 0;
-    struct listnode *l;
-    struct item *i;
+    struct state *state;
+    struct kernel kernels[NUM_SYMBOLS];
+    int index[NUM_SYMBOLS];
+};
 
-    for (l=state->items; l!=NULL; l=l->next)
-    {
-        i = (struct item *)l->data;
+/*
+ * successor_item is an item of a state advanced over the symbol after its
+ * cursor.
+ */
+struct successor_item
+{
+    int symbol;
+    int core;
+    const struct lookahead *lookahead;
+};
 
-        if (item->rewrite_rule == i->rewrite_rule &&
-            item->cursor_position == i->cursor_position &&
-            list_equal(item->lookahead, i->lookahead))
-        {
-            contains = 1;
-            break;
-        }
+static int
+compare_successor_items(const void *a, const void *b)
+{
+    const struct successor_item *x = (const struct successor_item *)a;
+    const struct successor_item *y = (const struct successor_item *)b;
+
+    if (x->symbol != y->symbol)
+    {
+        return x->symbol - y->symbol;
     }
-    return contains;
+    return x->core - y->core;
 }
 
-int
-compare_states(struct state *a, struct state *b)
+/*
+ * Find the kernels reached by each symbol of a state and look up the global
+ * states they match. Global states are only read, so the transitions of
+ * several states can be found at once.
+ */
+static void
+find_transitions(struct transitions *t)
 {
-    int index, i, compare;
-    struct listnode *l;
+    struct kernel *kernel = &t->state->kernel;
+    struct closure closure;
+    struct successor_item *items;
+    struct rule *rule;
+    int i, j, k, size, position, symbol;
 
-    compare = 0;
+    memset(t->kernels, 0, sizeof(t->kernels));
+    kernel_closure(kernel, &closure);
 
-    if ((a == NULL && b != NULL) || (a != NULL && b == NULL))
-    {
-        return -1;
-    }
+    items = malloc(sizeof(struct successor_item) * (kernel->size + NUM_RULES));
+    assert(items != NULL);
+    size = 0;
 
     /*
-     * Check that indexed state contains everything in state.
+     * Advance the kernel items that contain another consumable value, and
+     * every rule of the nonterminals in the closure.
      */
-    for (l=a->items; l!=NULL; l=l->next)
+    for (i=0; i<kernel->size; i++)
     {
-        if (!state_contains_item(b, (struct item *)l->data))
+        rule = core_rule(kernel->cores[i]);
+        position = core_position(kernel->cores[i]);
+
+        if (position < rule->length_of_nodes)
         {
-            compare = -1;
-            break;
+            items[size].symbol = INDEX(rule->nodes[position]);
+            items[size].core = kernel->cores[i] + 1;
+            items[size].lookahead = &kernel->lookaheads[i];
+            size++;
+        }
+    }
+
+    for (i=0; i<NUM_RULES; i++)
+    {
+        if (closure.contains[INDEX(grammar[i].type)] &&
+            grammar[i].length_of_nodes > 0)
+        {
+            items[size].symbol = INDEX(grammar[i].nodes[0]);
+            items[size].core = item_core(&grammar[i], 1);
+            items[size].lookahead = &closure.lookaheads[INDEX(grammar[i].type)];
+            size++;
         }
     }
 
+    qsort(items, size, sizeof(struct successor_item), compare_successor_items);
+
     /*
-     * Inverse check that state contains everything in indexed state.
+     * The items of each symbol become the kernel of its successor, in order of
+     * their cores. Items with the same core have their lookaheads unioned.
      */
-    for (l=b->items; l!=NULL; l=l->next)
+    for (i=0; i<size; i=j)
     {
-        if (!state_contains_item(a, (struct item *)l->data))
+        symbol = items[i].symbol;
+
+        for (j=i, k=0; j<size && items[j].symbol == symbol; j++)
         {
-            compare = 1;
-            break;
+            k += j == i || items[j].core != items[j - 1].core;
+        }
+
+        kernel_alloc(&t->kernels[symbol], k);
+
+        for (j=i, k=-1; j<size && items[j].symbol == symbol; j++)
+        {
+            if (j == i || items[j].core != items[j - 1].core)
+            {
+                k++;
+                t->kernels[symbol].cores[k] = items[j].core;
+                t->kernels[symbol].lookaheads[k] = *items[j].lookahead;
+            }
+            else
+            {
+                lookahead_union(&t->kernels[symbol].lookaheads[k],
+                                items[j].lookahead);
+            }
         }
+
+        t->index[symbol] = index_of_state(&t->kernels[symbol]);
     }
 
-    return compare;
+    free(items);
 }
 
 /*
- * Returns the index of a state in global states that has identical items or -1
- * if does not exist.
+ * Link a state to the global states of its transitions. Successors that were
+ * not found are looked up again, since a state linked earlier may have added
+ * them, and otherwise added as new states. The kernels of successors that
+ * already exist are freed.
  */
-int
-index_of_state(struct state *state)
+static void
+link_transitions(struct transitions *t)
 {
-    int index, i, match;
-    struct listnode *l;
+    struct kernel *kernel;
+    int index;
 
-    index = -1;
-    for (i=0; i<state_identifier; i++)
+    for (index=0; index<NUM_SYMBOLS; index++)
     {
-        if (compare_states(state, &states[i]) == 0)
+        kernel = &t->kernels[index];
+
+        if (kernel->size == 0)
         {
-            index = i;
-            break;
+            continue;
         }
-    }
 
-    return index;
+        if (t->index[index] == -1)
+        {
+            t->index[index] = lookup_state(kernel);
+        }
+
+        if (t->index[index] == -1)
+        {
+            t->index[index] = add_state(kernel)->identifier;
+        }
+        else
+        {
+            free(kernel->lookaheads);
+        }
+
+        t->state->links[index] = states[t->index[index]];
+    }
 }
 
-#ifdef GENPT
+/*
+ * Generate the transitions of a state. The kernel reached by each symbol is
+ * linked to the global state with an identical kernel, which is added if it
+ * does not exist yet. New states are not followed here, their transitions are
+ * generated when generate_states() reaches them.
+ */
 void
-init_parsetable(void)
+generate_transitions(struct state *s)
 {
-    int i, j;
-    struct parsetable_item *row, *cell;
-    struct state *state;
-    struct listnode *node, *inner_node;
-    struct item *item;
-    int lookahead;
-    FILE *fp;
-
-    if (parsetable != NULL)
-    {
-        return;
-    }
+    struct transitions *t;
 
-    generate_states();
+    t = malloc(sizeof(struct transitions));
+    assert(t != NULL);
 
-    parsetable = malloc(sizeof(struct parsetable_item) * (NUM_SYMBOLS) * (state_identifier + 1));
-    memset(parsetable, 0, sizeof(struct parsetable_item) * NUM_SYMBOLS * (state_identifier + 1));
+    t->state = s;
+    find_transitions(t);
+    link_transitions(t);
 
-    for (i=0; i<state_identifier; i++)
-    {
-        state = &states[i];
-        row = &parsetable[state->identifier * NUM_SYMBOLS];
+    free(t);
+}
 
-        for (j=0; j<NUM_SYMBOLS; j++)
-        {
-            cell = row + j;
-
-            if (state->links[j] != NULL && j > AST_INVALID)
-            {
-                /*
-                 * non-terminal value
-                 */
-                cell->state = state->links[j]->identifier;
-            }
-            else if (state->links[j] != NULL && j < AST_INVALID)
-            {
-                /*
-                 * terminal value
-                 */
-                cell->shift = 1;
-                cell->state = state->links[j]->identifier;
-            }
-        }
-
-        /*
-         * Iterate over all items and for each completed rules add to parse
-         * table based on lookahead.
-         */
-        foreach(node, state->items)
-        {
-            item = ((struct item *)node->data);
-            if (item->cursor_position == item->rewrite_rule->length_of_nodes)
-            {
-                foreach(inner_node, item->lookahead)
-                {
-                    lookahead = (int)inner_node->data;
-                    cell = row + lookahead;
-
-                    cell->reduce = 1;
-                    cell->rule = item->rewrite_rule;
-                }
+#ifdef GENPT
+/*
+ * generate_threads is the number of threads that find the transitions of a
+ * frontier of states.
+ */
+static int generate_threads = 1;
 
-                if (item->lookahead == NULL)
-                {
-                    /*
-                     * NULL lookahead means end of input (e.g. $). Since
-                     * nothing should match AST_INVALID, let's use that column
-                     * for NULL lookahead items.
-                     */
-                    cell = row + AST_INVALID;
-
-                    cell->reduce = 1;
-                    cell->rule = item->rewrite_rule;
-                }
-            }
-        }
-    }
+/*
+ * frontier is the states whose transitions are being found by the threads.
+ * Each thread takes the next state until there are none left.
+ */
+struct frontier
+{
+    struct transitions *transitions;
+    int size;
+    int next;
+};
 
-    fp = fopen("parsetable.h", "w");
-    fprintf(fp, "/*\n");
-    fprintf(fp, " * Generated parse table file:\n");
-    fprintf(fp, " */\n");
-    fprintf(fp, " #include \"grammar.h\"\n");
-    fprintf(fp, "struct parsetable_item parsetable[%d] =\n", state_identifier * NUM_SYMBOLS);
-    fprintf(fp, "{\n");
+static void *
+frontier_thread(void *arg)
+{
+    struct frontier *frontier = (struct frontier *)arg;
+    int i;
 
-    for (i=0; i<state_identifier; i++)
+    while ((i = __sync_fetch_and_add(&frontier->next, 1)) < frontier->size)
     {
-        state = &states[i];
-        row = &parsetable[state->identifier * NUM_SYMBOLS];
-
-        for (j=0; j<NUM_SYMBOLS; j++)
-        {
-            cell = row + j;
-
-            fprintf(fp, "{ &grammar[%ld], %d, %d, %d },",
-                    cell->reduce ? cell->rule-grammar : 0,
-                    cell->shift, cell->reduce, cell->state);
-        }
-        fprintf(fp, "\n");
+        find_transitions(&frontier->transitions[i]);
     }
 
-    fprintf(fp, "};\n");
-    fclose(fp);
+    return NULL;
 }
-#endif
 
-struct astnode *
-token_to_astnode(struct token *token)
+/*
+ * Generate the transitions of global states start to end on generate_threads
+ * threads. The transitions are found in parallel but linked in order, so the
+ * new states are numbered the same as when one state is generated at a time.
+ */
+static void
+generate_frontier(int start, int end)
 {
-    struct astnode *node;
-    if (token->type == TOK_INTEGER)
+    struct frontier frontier;
+    pthread_t *threads;
+    int i, count;
+
+    frontier.size = end - start;
+    frontier.next = 0;
+    frontier.transitions = malloc(sizeof(struct transitions) * frontier.size);
+    assert(frontier.transitions != NULL);
+
+    for (i=0; i<frontier.size; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_INTEGER_CONSTANT;
-        node->token = token;
+        frontier.transitions[i].state = states[start + i];
     }
-    if (token->type == TOK_STRING)
+
+    count = generate_threads < frontier.size ? generate_threads : frontier.size;
+    threads = malloc(sizeof(pthread_t) * count);
+
+    for (i=0; i<count; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_STRING_CONSTANT;
-        node->token = token;
+        if (pthread_create(&threads[i], NULL, frontier_thread, &frontier) != 0)
+        {
+            break;
+        }
     }
-    else if (token->type == TOK_IDENTIFIER)
+
+    /*
+     * Whatever the threads that could not be started would have done is left
+     * to this one.
+     */
+    frontier_thread(&frontier);
+
+    while (i-- > 0)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_IDENTIFIER;
-        node->token = token;
+        pthread_join(threads[i], NULL);
     }
-    else if (token->type == TOK_PLUS)
+
+    for (i=0; i<frontier.size; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_PLUS;
-        node->token = token;
+        link_transitions(&frontier.transitions[i]);
     }
-    else if (token->type == TOK_PLUS_PLUS)
+
+    free(threads);
+    free(frontier.transitions);
+}
+#endif
+
+/*
+ * Generates all state for grammar and returns the root state. States are
+ * taken from a first in, first out worklist so that no recursion is needed
+ * however deep the grammar is.
+ */
+struct state *
+generate_states(void)
+{
+    struct kernel root;
+    int i, start, end;
+
+    state_identifier = 0;
+    if (state_table != NULL)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_PLUS_PLUS;
-        node->token = token;
+        memset(state_table, 0, sizeof(int) * state_table_size);
     }
-    else if (token->type == TOK_PLUS_EQUAL)
+
+    /*
+     * FIRST sets and cores are initialized lazily, which must not happen once
+     * several threads use them.
+     */
+    if (!first_sets_initialized)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_PLUS_EQUAL;
-        node->token = token;
+        init_first_sets();
     }
-    else if (token->type == TOK_MINUS)
+    if (cores_size == 0)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_MINUS;
-        node->token = token;
+        init_cores();
     }
-    else if (token->type == TOK_MINUS_MINUS)
+
+    /*
+     * The kernel of the root state is the start of every rule of the
+     * translation unit, followed by end of input.
+     */
+    for (i=0, end=0; i<NUM_RULES; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_MINUS_MINUS;
-        node->token = token;
+        end += grammar[i].type == AST_TRANSLATION_UNIT;
     }
-    else if (token->type == TOK_MINUS_EQUAL)
+
+    kernel_alloc(&root, end);
+    memset(root.lookaheads, 0, sizeof(struct lookahead) * root.size);
+
+    for (i=0, end=0; i<NUM_RULES; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_MINUS_EQUAL;
-        node->token = token;
+        if (grammar[i].type == AST_TRANSLATION_UNIT)
+        {
+            root.cores[end] = item_core(&grammar[i], 0);
+            lookahead_add(&root.lookaheads[end], AST_INVALID);
+            end++;
+        }
     }
-    else if (token->type == TOK_AMPERSAND)
+
+    root.fingerprint = kernel_fingerprint(&root);
+    add_state(&root);
+
+    /*
+     * Transitions only ever add states at the end of global states, so
+     * walking it in order visits every state once. Each pass handles the
+     * frontier of states added by the previous one.
+     */
+    for (start=0; start<state_identifier; start=end)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_AMPERSAND;
-        node->token = token;
+        end = state_identifier;
+
+#ifdef GENPT
+        if (generate_threads > 1)
+        {
+            generate_frontier(start, end);
+            continue;
+        }
+#endif
+
+        for (; start<end; start++)
+        {
+            generate_transitions(states[start]);
+        }
     }
-    else if (token->type == TOK_AMPERSAND_AMPERSAND)
+
+    return states[0];
+}
+
+static unsigned long
+hash_combine(unsigned long hash, unsigned long value)
+{
+    hash ^= value;
+    hash *= FNV_PRIME;
+    return hash;
+}
+
+unsigned long
+lookahead_hash(const struct lookahead *lookahead)
+{
+    unsigned long hash = FNV_OFFSET_BASIS;
+    int i;
+
+    for (i=0; i<LOOKAHEAD_WORDS; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_AMPERSAND_AMPERSAND;
-        node->token = token;
+        hash = hash_combine(hash, lookahead->words[i]);
     }
-    else if (token->type == TOK_ASTERISK)
+    return hash;
+}
+
+/*
+ * Returns a hash of the symbols and the order and lengths of the rules of the
+ * grammar, and of which rules are created by create_elided_node(), since
+ * eliding unit rules skips their reductions. Together with genpt itself and
+ * its options, this is all a parse table depends on.
+ */
+unsigned long
+grammar_hash(void)
+{
+    unsigned long hash = FNV_OFFSET_BASIS;
+    int i, j;
+
+    hash = hash_combine(hash, NUM_TERMINALS);
+    hash = hash_combine(hash, NUM_SYMBOLS);
+    hash = hash_combine(hash, NUM_RULES);
+
+    for (i=0; i<NUM_RULES; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_ASTERISK;
-        node->token = token;
+        hash = hash_combine(hash, grammar[i].type);
+        hash = hash_combine(hash, grammar[i].length_of_nodes);
+        hash = hash_combine(hash, grammar[i].create == create_elided_node);
+
+        for (j=0; j<grammar[i].length_of_nodes; j++)
+        {
+            hash = hash_combine(hash, grammar[i].nodes[j]);
+        }
     }
-    else if (token->type == TOK_ASTERISK_EQUAL)
+
+    return hash;
+}
+
+/*
+ * Returns whether two kernels have identical items. Kernel items are kept in
+ * order of their cores, so identical kernels have identical arrays.
+ */
+int
+kernels_equal(struct kernel *a, struct kernel *b)
+{
+    return a->size == b->size &&
+           memcmp(a->cores, b->cores, sizeof(int) * a->size) == 0 &&
+           memcmp(a->lookaheads, b->lookaheads,
+                  sizeof(struct lookahead) * a->size) == 0;
+}
+
+/*
+ * Returns the fingerprint of a kernel.
+ */
+unsigned long
+kernel_fingerprint(struct kernel *kernel)
+{
+    unsigned long fingerprint = FNV_OFFSET_BASIS;
+    int i;
+
+    for (i=0; i<kernel->size; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_ASTERISK_EQUAL;
-        node->token = token;
+        fingerprint = hash_combine(fingerprint, kernel->cores[i]);
+        fingerprint = hash_combine(fingerprint,
+                                   lookahead_hash(&kernel->lookaheads[i]));
     }
-    else if (token->type == TOK_BACKSLASH)
+
+    return fingerprint;
+}
+
+/*
+ * Double the size of the state table and insert the first count global states
+ * again.
+ */
+static void
+grow_state_table(int count)
+{
+    unsigned long slot;
+    int index;
+
+    state_table_size = state_table_size ? state_table_size * 2 :
+                       STATE_TABLE_INITIAL_SIZE;
+
+    free(state_table);
+    state_table = calloc(state_table_size, sizeof(int));
+    assert(state_table != NULL);
+
+    for (index=0; index<count; index++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_BACKSLASH;
-        node->token = token;
+        slot = states[index]->kernel.fingerprint & (state_table_size - 1);
+        while (state_table[slot] != 0)
+        {
+            slot = (slot + 1) & (state_table_size - 1);
+        }
+
+        state_table[slot] = index + 1;
     }
-    else if (token->type == TOK_BACKSLASH_EQUAL)
+}
+
+/*
+ * Add a global state to the state table. The kernel fingerprint must already
+ * be computed, and every state before it must already be in the table.
+ */
+static void
+insert_state(int index)
+{
+    unsigned long slot;
+
+    if ((unsigned long)(index + 1) * 2 > state_table_size)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_BACKSLASH_EQUAL;
-        node->token = token;
+        grow_state_table(index);
     }
-    else if (token->type == TOK_CARET)
+
+    slot = states[index]->kernel.fingerprint & (state_table_size - 1);
+    while (state_table[slot] != 0)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_CARET;
-        node->token = token;
+        slot = (slot + 1) & (state_table_size - 1);
     }
-    else if (token->type == TOK_COMMA)
+
+    state_table[slot] = index + 1;
+}
+
+/*
+ * Returns the index of the global state with an identical kernel or -1 if
+ * does not exist. The kernel fingerprint must already be computed.
+ */
+static int
+lookup_state(struct kernel *kernel)
+{
+    unsigned long slot;
+    int index;
+
+    if (state_table == NULL)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_COMMA;
-        node->token = token;
+        return -1;
     }
-    else if (token->type == TOK_ELLIPSIS)
+
+    slot = kernel->fingerprint & (state_table_size - 1);
+    while (state_table[slot] != 0)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_ELLIPSIS;
-        node->token = token;
+        index = state_table[slot] - 1;
+
+        if (states[index]->kernel.fingerprint == kernel->fingerprint &&
+            kernels_equal(kernel, &states[index]->kernel))
+        {
+            return index;
+        }
+
+        slot = (slot + 1) & (state_table_size - 1);
     }
-    else if (token->type == TOK_MOD)
+
+    return -1;
+}
+
+/*
+ * Returns the index of the global state with an identical kernel or -1 if
+ * does not exist. Only states with a matching fingerprint are compared.
+ */
+int
+index_of_state(struct kernel *kernel)
+{
+    kernel->fingerprint = kernel_fingerprint(kernel);
+    return lookup_state(kernel);
+}
+
+#ifdef GENPT
+/*
+ * Add reductions of a rule on each terminal of a lookahead to a row of a parse
+ * table. Returns the number of cells where a different rule was already
+ * reduced, which are flagged in conflicts when it is not NULL. The rule that
+ * comes first in the grammar wins those cells.
+ */
+static int
+add_reductions(struct parsetable_item *table, struct parsetable_item *row,
+               struct rule *rule, const struct lookahead *lookahead,
+               char *conflicts)
+{
+    struct parsetable_item *cell;
+    int terminal, total_conflicts = 0;
+
+    /*
+     * End of input lookahead is stored as AST_INVALID so it lands in the
+     * AST_INVALID column, which no terminal can match.
+     */
+    for (terminal=0; terminal<NUM_TERMINALS; terminal++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_MOD;
-        node->token = token;
+        if (!lookahead_contains(lookahead, terminal))
+        {
+            continue;
+        }
+
+        cell = row + terminal;
+
+        if (cell->reduce && cell->rule != rule)
+        {
+            total_conflicts++;
+            if (conflicts != NULL)
+            {
+                conflicts[cell - table] = 1;
+            }
+        }
+
+        if (!cell->reduce || rule < cell->rule)
+        {
+            cell->reduce = 1;
+            cell->rule = rule;
+        }
     }
-    else if (token->type == TOK_MOD_EQUAL)
+
+    return total_conflicts;
+}
+
+/*
+ * Fill a parse table with the shift, goto and reduce operations of the given
+ * states. Returns the number of cells where two different rules can be
+ * reduced, which are flagged in conflicts when it is not NULL.
+ */
+static int
+fill_parsetable(struct parsetable_item *table, struct state **table_states,
+                int count, char *conflicts)
+{
+    int i, j, total_conflicts = 0;
+    struct parsetable_item *row, *cell;
+    struct state *state;
+    struct closure closure;
+    struct rule *rule;
+
+    for (i=0; i<count; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_MOD_EQUAL;
-        node->token = token;
+        state = table_states[i];
+        row = &table[state->identifier * NUM_SYMBOLS];
+
+        for (j=0; j<NUM_SYMBOLS; j++)
+        {
+            cell = row + j;
+
+            if (state->links[j] != NULL && j > AST_INVALID)
+            {
+                /*
+                 * non-terminal value
+                 */
+                cell->state = state->links[j]->identifier;
+            }
+            else if (state->links[j] != NULL && j < AST_INVALID)
+            {
+                /*
+                 * terminal value
+                 */
+                cell->shift = 1;
+                cell->state = state->links[j]->identifier;
+            }
+        }
+
+        /*
+         * Completed rules are reduced on their lookahead. Those are the kernel
+         * items with the cursor at the end, and the rules without symbols of
+         * nonterminals in the closure.
+         */
+        for (j=0; j<state->kernel.size; j++)
+        {
+            rule = core_rule(state->kernel.cores[j]);
+            if (core_position(state->kernel.cores[j]) == rule->length_of_nodes)
+            {
+                total_conflicts += add_reductions(
+                    table, row, rule, &state->kernel.lookaheads[j], conflicts);
+            }
+        }
+
+        kernel_closure(&state->kernel, &closure);
+
+        for (j=0; j<NUM_RULES; j++)
+        {
+            if (grammar[j].length_of_nodes == 0 &&
+                closure.contains[INDEX(grammar[j].type)])
+            {
+                total_conflicts += add_reductions(
+                    table, row, &grammar[j],
+                    &closure.lookaheads[INDEX(grammar[j].type)], conflicts);
+            }
+        }
     }
-    else if (token->type == TOK_QUESTIONMARK)
+
+    return total_conflicts;
+}
+
+/*
+ * Merge global states that have identical cores to construct LALR(1) states.
+ * The closure of a state only depends on the cores of its kernel, so comparing
+ * the kernel cores is enough, and kernels with identical cores have their
+ * items in the same order. The lookaheads of items with the same core are
+ * unioned. Returns the number of merged states and stores the merged state of
+ * each global state in merged_index.
+ */
+static int
+merge_states(struct state ***merged_states, int *merged_index)
+{
+    int *representatives, *table;
+    int i, j, m, count;
+    unsigned long hash, slot, table_size;
+    struct state *merged, **merged_pointers;
+    struct kernel *kernel, *merged_kernel;
+
+    representatives = malloc(sizeof(int) * state_identifier);
+    count = 0;
+
+    /*
+     * The table of cores is kept at most half full.
+     */
+    for (table_size=STATE_TABLE_INITIAL_SIZE;
+         table_size<(unsigned long)state_identifier * 2; table_size*=2)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_QUESTIONMARK;
-        node->token = token;
     }
-    else if (token->type == TOK_COLON)
+    table = calloc(table_size, sizeof(int));
+
+    for (i=0; i<state_identifier; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_COLON;
-        node->token = token;
-    }
-    else if (token->type == TOK_SEMICOLON)
+        kernel = &states[i]->kernel;
+
+        hash = FNV_OFFSET_BASIS;
+        for (j=0; j<kernel->size; j++)
+        {
+            hash = hash_combine(hash, kernel->cores[j]);
+        }
+
+        /*
+         * Find a merged state with identical cores, or add a new one.
+         */
+        slot = hash & (table_size - 1);
+        while (table[slot] != 0)
+        {
+            merged_kernel = &states[representatives[table[slot] - 1]]->kernel;
+            if (merged_kernel->size == kernel->size &&
+                memcmp(merged_kernel->cores, kernel->cores,
+                       sizeof(int) * kernel->size) == 0)
+            {
+                break;
+            }
+            slot = (slot + 1) & (table_size - 1);
+        }
+
+        if (table[slot] == 0)
+        {
+            representatives[count] = i;
+            table[slot] = ++count;
+        }
+
+        merged_index[i] = table[slot] - 1;
+    }
+
+    merged = calloc(count, sizeof(struct state));
+
+    for (i=0; i<state_identifier; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_SEMICOLON;
-        node->token = token;
+        m = merged_index[i];
+        kernel = &states[i]->kernel;
+        merged_kernel = &merged[m].kernel;
+
+        if (representatives[m] == i)
+        {
+            merged[m].identifier = m;
+
+            kernel_alloc(merged_kernel, kernel->size);
+            memcpy(merged_kernel->cores, kernel->cores,
+                   sizeof(int) * kernel->size);
+            memcpy(merged_kernel->lookaheads, kernel->lookaheads,
+                   sizeof(struct lookahead) * kernel->size);
+        }
+        else
+        {
+            for (j=0; j<kernel->size; j++)
+            {
+                lookahead_union(&merged_kernel->lookaheads[j],
+                                &kernel->lookaheads[j]);
+            }
+        }
+
+        /*
+         * States with identical cores have transitions to states with
+         * identical cores, so any member can provide the links.
+         */
+        for (j=0; j<NUM_SYMBOLS; j++)
+        {
+            if (states[i]->links[j] != NULL)
+            {
+                merged[m].links[j] =
+                    &merged[merged_index[states[i]->links[j]->identifier]];
+            }
+        }
     }
-    else if (token->type == TOK_LPAREN)
+
+    free(representatives);
+    free(table);
+
+    merged_pointers = malloc(sizeof(struct state *) * count);
+    for (m=0; m<count; m++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_LPAREN;
-        node->token = token;
+        merged_pointers[m] = &merged[m];
     }
-    else if (token->type == TOK_RPAREN)
+
+    *merged_states = merged_pointers;
+    return count;
+}
+
+/*
+ * Returns whether reducing a rule only gives its single node the type of the
+ * rule.
+ */
+static int
+is_unit_rule(struct rule *rule)
+{
+    return rule->length_of_nodes == 1 && rule->create == create_elided_node;
+}
+
+/*
+ * Returns whether two rows of a parse table are identical.
+ */
+static int
+rows_equal(struct parsetable_item *a, struct parsetable_item *b)
+{
+    int i;
+
+    for (i=0; i<NUM_SYMBOLS; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_RPAREN;
-        node->token = token;
+        if (a[i].rule != b[i].rule || a[i].shift != b[i].shift ||
+            a[i].reduce != b[i].reduce || a[i].state != b[i].state)
+        {
+            return 0;
+        }
     }
-    else if (token->type == TOK_LBRACKET)
+    return 1;
+}
+
+static unsigned long
+row_hash(struct parsetable_item *row)
+{
+    unsigned long hash = FNV_OFFSET_BASIS;
+    int i;
+
+    for (i=0; i<NUM_SYMBOLS; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_LBRACKET;
-        node->token = token;
+        hash = hash_combine(hash, row[i].rule ? row[i].rule - grammar + 1 : 0);
+        hash = hash_combine(hash, row[i].shift | row[i].reduce << 1);
+        hash = hash_combine(hash, row[i].state);
     }
-    else if (token->type == TOK_RBRACKET)
+    return hash;
+}
+
+/*
+ * Returns whether a cell of a dense parse table is a transition to another
+ * state.
+ */
+static int
+is_transition(struct parsetable_item *cell, int symbol)
+{
+    return symbol < NUM_TERMINALS ? cell->shift : cell->state != 0;
+}
+
+/*
+ * Build the row of a state that replaces the transition of state row on
+ * symbol to state p of the original table, which reduces unit rules on some
+ * terminals. Reducing a unit rule only replaces the state on top of the stack
+ * by the goto on the rule type of the state below it, row, so the chain of
+ * unit reductions on each terminal is followed to the state it ends in, and
+ * the action of that state is used. The gotos of every state a chain ends in
+ * are kept. Returns 0 if two of them have different gotos on a symbol.
+ */
+static int
+build_elided_row(struct parsetable_item *original, int count,
+                 struct parsetable_item *row, int p,
+                 struct parsetable_item *elided)
+{
+    struct parsetable_item *cell;
+    int ends[NUM_TERMINALS];
+    int terminal, symbol, f, i, steps, ends_size = 0, valid = 1;
+
+    memset(elided, 0, sizeof(struct parsetable_item) * NUM_SYMBOLS);
+
+    for (terminal=0; terminal<NUM_TERMINALS; terminal++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_RBRACKET;
-        node->token = token;
+        f = p;
+        cell = &original[f * NUM_SYMBOLS + terminal];
+
+        for (steps=0; cell->reduce && is_unit_rule(cell->rule); steps++)
+        {
+            assert(steps < count);
+
+            f = row[INDEX(cell->rule->type)].state;
+            cell = &original[f * NUM_SYMBOLS + terminal];
+        }
+
+        elided[terminal] = *cell;
+
+        for (i=0; i<ends_size && ends[i]!=f; i++)
+        {
+        }
+        if (i == ends_size)
+        {
+            ends[ends_size++] = f;
+        }
     }
-    else if (token->type == TOK_LBRACE)
+
+    for (i=0; i<ends_size && valid; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_LBRACE;
-        node->token = token;
+        f = ends[i];
+
+        for (symbol=NUM_TERMINALS; symbol<NUM_SYMBOLS; symbol++)
+        {
+            cell = &original[f * NUM_SYMBOLS + symbol];
+
+            if (cell->state != 0 && elided[symbol].state != 0 &&
+                cell->state != elided[symbol].state)
+            {
+                valid = 0;
+                break;
+            }
+            else if (cell->state != 0)
+            {
+                elided[symbol] = *cell;
+            }
+        }
     }
-    else if (token->type == TOK_RBRACE)
+
+    return valid;
+}
+
+/*
+ * Double the size of the table of added states and insert the states from
+ * first to size of rows again.
+ */
+static int *
+grow_row_table(int *table, unsigned long *table_size,
+               struct parsetable_item *rows, int first, int size)
+{
+    unsigned long slot;
+    int index;
+
+    *table_size = table ? *table_size * 2 : STATE_TABLE_INITIAL_SIZE;
+
+    free(table);
+    table = calloc(*table_size, sizeof(int));
+    assert(table != NULL);
+
+    for (index=first; index<size; index++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_RBRACE;
-        node->token = token;
+        slot = row_hash(&rows[index * NUM_SYMBOLS]) & (*table_size - 1);
+        while (table[slot] != 0)
+        {
+            slot = (slot + 1) & (*table_size - 1);
+        }
+
+        table[slot] = index + 1;
     }
-    else if (token->type == TOK_VERTICALBAR)
+
+    return table;
+}
+
+/*
+ * Rewrite parsetable so that the parser never reduces unit rules created by
+ * create_elided_node(). Every transition to a state that reduces such a rule
+ * on some terminal is replaced by a transition to a new state, which acts on
+ * each terminal as the state the chain of unit reductions ends in. New states
+ * are added until their own transitions have been rewritten as well, and
+ * states that can no longer be reached are dropped. The parser gives a node
+ * the type the skipped reductions would have given it when a rule using it is
+ * reduced.
+ *
+ * Returns the number of states in the rewritten table.
+ */
+static int
+elide_unit_rules(int count)
+{
+    struct parsetable_item *original, *rows, *unrewritten, *row, *elided;
+    int *table, *reachable, *stack;
+    unsigned long slot, table_size;
+    int size, capacity, i, j, p, index, stack_size;
+    char *has_unit;
+
+    original = parsetable;
+
+    has_unit = calloc(count, sizeof(char));
+    for (i=0; i<count; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_VERTICALBAR;
-        node->token = token;
+        for (j=0; j<NUM_TERMINALS; j++)
+        {
+            row = &original[i * NUM_SYMBOLS + j];
+            has_unit[i] |= row->reduce && is_unit_rule(row->rule);
+        }
     }
-    else if (token->type == TOK_VERTICALBAR_VERTICALBAR)
+
+    /*
+     * rows are rewritten as new states are added, and the chains are followed
+     * through the gotos of unrewritten, which only lead to original states.
+     * table finds added states by their unrewritten row.
+     */
+    size = capacity = count;
+    rows = malloc(sizeof(struct parsetable_item) * NUM_SYMBOLS * capacity);
+    unrewritten = malloc(sizeof(struct parsetable_item) * NUM_SYMBOLS * capacity);
+    memcpy(rows, original, sizeof(struct parsetable_item) * NUM_SYMBOLS * count);
+    memcpy(unrewritten, original,
+           sizeof(struct parsetable_item) * NUM_SYMBOLS * count);
+
+    table = grow_row_table(NULL, &table_size, unrewritten, count, count);
+    elided = malloc(sizeof(struct parsetable_item) * NUM_SYMBOLS);
+
+    for (i=0; i<size; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_VERTICALBAR_VERTICALBAR;
-        node->token = token;
+        for (j=0; j<NUM_SYMBOLS; j++)
+        {
+            row = &unrewritten[i * NUM_SYMBOLS];
+            p = row[j].state;
+
+            if (!is_transition(&row[j], j) || !has_unit[p] ||
+                !build_elided_row(original, count, row, p, elided))
+            {
+                continue;
+            }
+
+            /*
+             * Find an added state with the same row, or add a new one. The
+             * table is kept at most half full.
+             */
+            if ((unsigned long)(size - count + 1) * 2 > table_size)
+            {
+                table = grow_row_table(table, &table_size, unrewritten, count,
+                                       size);
+            }
+
+            slot = row_hash(elided) & (table_size - 1);
+            while (table[slot] != 0 &&
+                   !rows_equal(&unrewritten[(table[slot] - 1) * NUM_SYMBOLS],
+                               elided))
+            {
+                slot = (slot + 1) & (table_size - 1);
+            }
+
+            if (table[slot] == 0)
+            {
+                if (size == capacity)
+                {
+                    capacity *= 2;
+                    rows = realloc(rows, sizeof(struct parsetable_item) *
+                                   NUM_SYMBOLS * capacity);
+                    unrewritten = realloc(unrewritten,
+                                          sizeof(struct parsetable_item) *
+                                          NUM_SYMBOLS * capacity);
+                    assert(rows != NULL && unrewritten != NULL);
+                }
+
+                memcpy(&rows[size * NUM_SYMBOLS], elided,
+                       sizeof(struct parsetable_item) * NUM_SYMBOLS);
+                memcpy(&unrewritten[size * NUM_SYMBOLS], elided,
+                       sizeof(struct parsetable_item) * NUM_SYMBOLS);
+                table[slot] = ++size;
+            }
+
+            rows[i * NUM_SYMBOLS + j].state = table[slot] - 1;
+        }
     }
-    else if (token->type == TOK_SHIFTLEFT)
+
+    /*
+     * Number the states that can be reached from the root state, in the
+     * order they are found.
+     */
+    reachable = malloc(sizeof(int) * size);
+    stack = malloc(sizeof(int) * size);
+    memset(reachable, 0xff, sizeof(int) * size);
+
+    reachable[0] = 0;
+    stack[0] = 0;
+    stack_size = 1;
+
+    for (index=1; stack_size>0; )
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_SHIFTLEFT;
-        node->token = token;
+        row = &rows[stack[--stack_size] * NUM_SYMBOLS];
+
+        for (j=0; j<NUM_SYMBOLS; j++)
+        {
+            p = row[j].state;
+            if (is_transition(&row[j], j) && reachable[p] == -1)
+            {
+                reachable[p] = index++;
+                stack[stack_size++] = p;
+            }
+        }
     }
-    else if (token->type == TOK_SHIFTRIGHT)
+
+    parsetable = calloc(NUM_SYMBOLS * index, sizeof(struct parsetable_item));
+
+    for (i=0; i<size; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_SHIFTRIGHT;
-        node->token = token;
+        if (reachable[i] == -1)
+        {
+            continue;
+        }
+
+        row = &parsetable[reachable[i] * NUM_SYMBOLS];
+        memcpy(row, &rows[i * NUM_SYMBOLS],
+               sizeof(struct parsetable_item) * NUM_SYMBOLS);
+
+        for (j=0; j<NUM_SYMBOLS; j++)
+        {
+            if (is_transition(&row[j], j))
+            {
+                row[j].state = reachable[row[j].state];
+            }
+        }
     }
-    else if (token->type == TOK_LESSTHAN)
+
+    free(original);
+    free(rows);
+    free(unrewritten);
+    free(table);
+    free(elided);
+    free(has_unit);
+    free(reachable);
+    free(stack);
+
+    return index;
+}
+
+/*
+ * Print the reduce/reduce conflicts of the merged LALR(1) table that none of
+ * the canonical states it was merged from had. Returns the number of them.
+ */
+static int
+report_new_conflicts(char *clr_conflicts, char *lalr_conflicts,
+                     int *merged_index, int merged_count)
+{
+    int i, m, j, found, total = 0;
+
+    for (m=0; m<merged_count; m++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_LT;
-        node->token = token;
+        for (j=0; j<NUM_TERMINALS; j++)
+        {
+            if (!lalr_conflicts[m * NUM_SYMBOLS + j])
+            {
+                continue;
+            }
+
+            found = 0;
+            for (i=0; i<state_identifier && !found; i++)
+            {
+                found = merged_index[i] == m &&
+                        clr_conflicts[i * NUM_SYMBOLS + j];
+            }
+
+            if (!found)
+            {
+                printf("  new reduce/reduce conflict in state %d on symbol %d\n",
+                       m, j);
+                total++;
+            }
+        }
     }
-    else if (token->type == TOK_GREATERTHAN)
+
+    return total;
+}
+
+/*
+ * packed_table stores sparse rows of a table in shared value and check arrays
+ * using row displacement. An entry of row r and column c is found at
+ * base[r] + c if check[base[r] + c] is r, otherwise it has the default value
+ * of the row.
+ */
+struct packed_table
+{
+    int rows;
+    int columns;
+    int size;
+    unsigned short *defaults;
+    unsigned short *base;
+    unsigned short *check;
+    unsigned short *value;
+};
+
+/*
+ * Returns the most common non-zero value of a row, or zero if the row only
+ * contains zeros. Values that match the default are left out of the packed
+ * table.
+ */
+static unsigned short
+row_default(unsigned short *row, int columns, unsigned short mask)
+{
+    int i, j, count, best_count = 0;
+    unsigned short best = 0;
+
+    for (i=0; i<columns; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_GT;
-        node->token = token;
+        if (row[i] == 0 || (row[i] & mask) != mask)
+        {
+            continue;
+        }
+
+        count = 0;
+        for (j=i; j<columns; j++)
+        {
+            count += row[j] == row[i];
+        }
+
+        if (count > best_count)
+        {
+            best = row[i];
+            best_count = count;
+        }
     }
-    else if (token->type == TOK_LESSTHANEQUAL)
+
+    return best;
+}
+
+/*
+ * Pack the rows of a dense table. Only values that match mask may become the
+ * default value of a row. Zero values are left out along with values that
+ * match the default, so errors in a row with a default reduction become that
+ * reduction and are detected later. Rows are placed densest first at the
+ * lowest base where none of their entries collide with entries of rows
+ * already placed.
+ */
+static void
+pack_table(struct packed_table *table, unsigned short *dense, int rows,
+           int columns, unsigned short mask)
+{
+    int *order, *entries;
+    int i, j, k, r, base, capacity;
+    unsigned short *row;
+
+    table->rows = rows;
+    table->columns = columns;
+    table->defaults = calloc(rows, sizeof(unsigned short));
+    table->base = calloc(rows, sizeof(unsigned short));
+
+    order = malloc(sizeof(int) * rows);
+    entries = calloc(rows, sizeof(int));
+
+    for (i=0; i<rows; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_LTEQ;
-        node->token = token;
+        row = &dense[i * columns];
+        table->defaults[i] = row_default(row, columns, mask);
+
+        for (j=0; j<columns; j++)
+        {
+            entries[i] += row[j] != 0 && row[j] != table->defaults[i];
+        }
+
+        /*
+         * Insertion sort the rows by decreasing number of entries.
+         */
+        for (k=i; k>0 && entries[order[k - 1]] < entries[i]; k--)
+        {
+            order[k] = order[k - 1];
+        }
+        order[k] = i;
     }
-    else if (token->type == TOK_GREATERTHANEQUAL)
+
+    capacity = rows * columns + columns;
+    table->check = malloc(sizeof(unsigned short) * capacity);
+    table->value = calloc(capacity, sizeof(unsigned short));
+    memset(table->check, 0xff, sizeof(unsigned short) * capacity);
+    table->size = 0;
+
+    for (i=0; i<rows; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_GTEQ;
-        node->token = token;
+        r = order[i];
+        row = &dense[r * columns];
+
+        for (base=0; ; base++)
+        {
+            for (j=0; j<columns; j++)
+            {
+                if (row[j] != 0 && row[j] != table->defaults[r] &&
+                    table->check[base + j] != PACKED_EMPTY)
+                {
+                    break;
+                }
+            }
+
+            if (j == columns)
+            {
+                break;
+            }
+        }
+
+        table->base[r] = base;
+        for (j=0; j<columns; j++)
+        {
+            if (row[j] != 0 && row[j] != table->defaults[r])
+            {
+                table->check[base + j] = r;
+                table->value[base + j] = row[j];
+            }
+        }
+
+        /*
+         * Every row must be able to look up all of its columns without
+         * reading past the end of the table.
+         */
+        if (base + columns > table->size)
+        {
+            table->size = base + columns;
+        }
+    }
+
+    assert(table->size <= PACKED_EMPTY);
+
+    free(order);
+    free(entries);
+}
+
+static void
+write_array(FILE *fp, const char *name, unsigned short *values, int size)
+{
+    int i;
+
+    fprintf(fp, "static const unsigned short %s[%d] =\n", name, size);
+    fprintf(fp, "{");
+
+    for (i=0; i<size; i++)
+    {
+        fprintf(fp, "%s%d,", i % 16 == 0 ? "\n    " : " ", values[i]);
     }
-    else if (token->type == TOK_EQ)
+
+    fprintf(fp, "\n};\n\n");
+}
+
+static void
+write_packed_table(FILE *fp, const char *name, struct packed_table *table)
+{
+    char array_name[64];
+
+    snprintf(array_name, sizeof(array_name), "parsetable_%s_default", name);
+    write_array(fp, array_name, table->defaults, table->rows);
+
+    snprintf(array_name, sizeof(array_name), "parsetable_%s_base", name);
+    write_array(fp, array_name, table->base, table->rows);
+
+    snprintf(array_name, sizeof(array_name), "parsetable_%s_check", name);
+    write_array(fp, array_name, table->check, table->size);
+
+    snprintf(array_name, sizeof(array_name), "parsetable_%s_value", name);
+    write_array(fp, array_name, table->value, table->size);
+}
+
+static void
+write_binary_table(FILE *fp, struct packed_table *table)
+{
+    fwrite(table->defaults, sizeof(unsigned short), table->rows, fp);
+    fwrite(table->base, sizeof(unsigned short), table->rows, fp);
+    fwrite(table->check, sizeof(unsigned short), table->size, fp);
+    fwrite(table->value, sizeof(unsigned short), table->size, fp);
+}
+
+/*
+ * Write the packed tables to PARSETABLE_FILENAME in the layout read by
+ * load_parsetable().
+ */
+static void
+write_parsetable_file(int count, unsigned long key, int elided,
+                      struct packed_table *action_table,
+                      struct packed_table *goto_table)
+{
+    struct parsetable_header header;
+    FILE *fp;
+
+    memset(&header, 0, sizeof(struct parsetable_header));
+    memcpy(header.magic, PARSETABLE_MAGIC, sizeof(PARSETABLE_MAGIC));
+    header.grammar_hash = grammar_hash();
+    header.key = key;
+    header.version = PARSETABLE_VERSION;
+    header.states = count;
+    header.terminals = NUM_TERMINALS;
+    header.nonterminals = NUM_NONTERMINALS;
+    header.rules = NUM_RULES;
+    header.action_size = action_table->size;
+    header.goto_size = goto_table->size;
+    header.elided = elided;
+
+    fp = fopen(PARSETABLE_FILENAME, "wb");
+    assert(fp != NULL);
+    fwrite(&header, sizeof(struct parsetable_header), 1, fp);
+    write_binary_table(fp, action_table);
+    write_binary_table(fp, goto_table);
+    fclose(fp);
+}
+
+/*
+ * Write parsetable.h with separate ACTION and GOTO tables. ACTION rows are
+ * states indexed by terminal and hold packed actions, with the most common
+ * reduction of a state as its default. GOTO rows are non-terminals indexed by
+ * state and hold the next state, with the most common state as default. The
+ * grammar hash and key are defined first so that genpt can tell whether the
+ * file is up to date.
+ */
+static void
+write_parsetable(int count, unsigned long key, int elided)
+{
+    unsigned short *actions, *gotos;
+    struct packed_table action_table, goto_table;
+    struct parsetable_item *cell;
+    int i, j;
+    FILE *fp;
+
+    assert(count <= ACTION_MAX_VALUE);
+
+    actions = calloc(count * NUM_TERMINALS, sizeof(unsigned short));
+    gotos = calloc(NUM_NONTERMINALS * count, sizeof(unsigned short));
+
+    for (i=0; i<count; i++)
+    {
+        for (j=0; j<NUM_SYMBOLS; j++)
+        {
+            cell = &parsetable[i * NUM_SYMBOLS + j];
+
+            if (j < NUM_TERMINALS && cell->shift)
+            {
+                actions[i * NUM_TERMINALS + j] = ACTION_SHIFT | cell->state;
+            }
+            else if (j < NUM_TERMINALS && cell->reduce)
+            {
+                actions[i * NUM_TERMINALS + j] =
+                    ACTION_REDUCE | (cell->rule - grammar);
+            }
+            else if (j >= NUM_TERMINALS)
+            {
+                gotos[(j - NUM_TERMINALS) * count + i] = cell->state;
+            }
+        }
+    }
+
+    pack_table(&action_table, actions, count, NUM_TERMINALS, ACTION_REDUCE);
+    pack_table(&goto_table, gotos, NUM_NONTERMINALS, count, 0);
+
+    printf("ACTION entries: %d\n", action_table.size);
+    printf("GOTO entries: %d\n", goto_table.size);
+
+    fp = fopen("parsetable.h", "w");
+    fprintf(fp, "/*\n");
+    fprintf(fp, " * Generated parse table file:\n");
+    fprintf(fp, " */\n");
+    fprintf(fp, "#define PARSETABLE_GRAMMAR_HASH 0x%016lxUL\n", grammar_hash());
+    fprintf(fp, "#define PARSETABLE_KEY 0x%016lxUL\n", key);
+    fprintf(fp, "#define PARSETABLE_STATES %d\n", count);
+    fprintf(fp, "#define PARSETABLE_ELIDED %d\n\n", elided);
+    write_packed_table(fp, "action", &action_table);
+    write_packed_table(fp, "goto", &goto_table);
+    fclose(fp);
+
+    write_parsetable_file(count, key, elided, &action_table, &goto_table);
+
+    free(actions);
+    free(gotos);
+}
+
+/*
+ * Hash of the genpt binary, so that changes to how tables are built, and not
+ * only to the grammar, make tables generated before them out of date.
+ */
+static unsigned long generator_hash;
+
+/*
+ * Returns a hash of the contents of the file, or 0 if it can't be read.
+ */
+static unsigned long
+file_hash(const char *filename)
+{
+    unsigned long hash = FNV_OFFSET_BASIS;
+    unsigned char buffer[4096];
+    size_t size, i;
+    FILE *fp;
+
+    fp = fopen(filename, "rb");
+    if (fp == NULL)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_EQ;
-        node->token = token;
+        return 0;
     }
-    else if (token->type == TOK_NEQ)
+
+    while ((size = fread(buffer, 1, sizeof(buffer), fp)) > 0)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_NEQ;
-        node->token = token;
+        for (i=0; i<size; i++)
+        {
+            hash = hash_combine(hash, buffer[i]);
+        }
     }
-    else if (token->type == TOK_EQUAL)
+    fclose(fp);
+
+    return hash;
+}
+
+/*
+ * Returns the key of the parse table generated from the grammar by this genpt
+ * with the given options. Options that don't change the table, like threads,
+ * are left out.
+ */
+static unsigned long
+parsetable_key(struct parsetable_options *options)
+{
+    unsigned long key = grammar_hash();
+
+    key = hash_combine(key, generator_hash);
+    key = hash_combine(key, PARSETABLE_VERSION);
+    key = hash_combine(key, options->lalr);
+    key = hash_combine(key, options->elide_unit_rules);
+
+    return key;
+}
+
+/*
+ * Returns whether parsetable.h and PARSETABLE_FILENAME in the current
+ * directory were both generated with the given key.
+ */
+static int
+parsetable_current(unsigned long key)
+{
+    struct parsetable_header header;
+    char line[128];
+    unsigned long found;
+    int current = 0;
+    FILE *fp;
+
+    fp = fopen("parsetable.h", "r");
+    if (fp == NULL)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_EQUAL;
-        node->token = token;
+        return 0;
     }
-    else if (token->type == TOK_VOID)
+
+    while (fgets(line, sizeof(line), fp) != NULL)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_VOID;
-        node->token = token;
+        if (sscanf(line, "#define PARSETABLE_KEY 0x%lx", &found) == 1)
+        {
+            current = found == key;
+            break;
+        }
     }
-    else if (token->type == TOK_SHORT)
+    fclose(fp);
+
+    if (!current)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_SHORT;
-        node->token = token;
+        return 0;
     }
-    else if (token->type == TOK_INT)
+
+    fp = fopen(PARSETABLE_FILENAME, "rb");
+    if (fp == NULL)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_INT;
-        node->token = token;
+        return 0;
     }
-    else if (token->type == TOK_CHAR)
+
+    current = fread(&header, sizeof(struct parsetable_header), 1, fp) == 1 &&
+              header.version == PARSETABLE_VERSION && header.key == key;
+    fclose(fp);
+
+    return current;
+}
+
+/*
+ * Returns the directory generated parse tables are cached in, creating it if
+ * needed, or NULL if there is none. Caching is opt-in: there is a cache only
+ * when CLINK_CACHE_DIR is set.
+ */
+static const char *
+cache_directory(void)
+{
+    static char directory[PATH_MAX];
+    struct stat st;
+    const char *base;
+    char *p;
+
+    if ((base = getenv("CLINK_CACHE_DIR")) == NULL || base[0] == '\0')
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_CHAR;
-        node->token = token;
+        return NULL;
     }
-    else if (token->type == TOK_LONG)
+    snprintf(directory, sizeof(directory), "%s", base);
+
+    for (p=directory+1; *p!='\0'; p++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_LONG;
-        node->token = token;
+        if (*p == '/')
+        {
+            *p = '\0';
+            mkdir(directory, 0755);
+            *p = '/';
+        }
     }
-    else if (token->type == TOK_FLOAT)
+    mkdir(directory, 0755);
+
+    if (stat(directory, &st) < 0 || !S_ISDIR(st.st_mode))
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_FLOAT;
-        node->token = token;
+        return NULL;
     }
-    else if (token->type == TOK_DOUBLE)
+
+    return directory;
+}
+
+/*
+ * Copy a file. The copy is written to a temporary file that is then renamed,
+ * so that builds sharing a cache never see a partial file. Returns 0 on
+ * success or -1 on failure.
+ */
+static int
+copy_file(const char *from, const char *to)
+{
+    char buffer[8192], temporary[PATH_MAX];
+    FILE *in, *out;
+    size_t size;
+    int error = 0;
+
+    in = fopen(from, "rb");
+    if (in == NULL)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_DOUBLE;
-        node->token = token;
+        return -1;
     }
-    else if (token->type == TOK_SIGNED)
+
+    snprintf(temporary, sizeof(temporary), "%s.%d.tmp", to, (int)getpid());
+    out = fopen(temporary, "wb");
+    if (out == NULL)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_SIGNED;
-        node->token = token;
+        fclose(in);
+        return -1;
     }
-    else if (token->type == TOK_UNSIGNED)
+
+    while ((size = fread(buffer, 1, sizeof(buffer), in)) > 0)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_UNSIGNED;
-        node->token = token;
+        if (fwrite(buffer, 1, size, out) != size)
+        {
+            error = 1;
+            break;
+        }
     }
-    else if (token->type == TOK_AUTO)
+
+    error |= ferror(in);
+    fclose(in);
+    error |= fclose(out) != 0;
+
+    if (error || rename(temporary, to) != 0)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_AUTO;
-        node->token = token;
+        remove(temporary);
+        return -1;
     }
-    else if (token->type == TOK_REGISTER)
+
+    return 0;
+}
+
+void
+init_parsetable(struct parsetable_options *options)
+{
+    int count, clr_conflicts;
+    struct parsetable_item *clr_parsetable;
+    struct state **table_states;
+    char *clr_conflict_cells, *lalr_conflict_cells;
+    int *merged_index;
+
+    if (parsetable != NULL)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_REGISTER;
-        node->token = token;
+        return;
     }
-    else if (token->type == TOK_STATIC)
+
+    if (options->threads > 1)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_STATIC;
-        node->token = token;
+        generate_threads = options->threads;
     }
-    else if (token->type == TOK_EXTERN)
+    generate_states();
+
+    count = state_identifier;
+    table_states = states;
+
+    clr_parsetable = calloc(NUM_SYMBOLS * state_identifier,
+                            sizeof(struct parsetable_item));
+    clr_conflict_cells = calloc(NUM_SYMBOLS * state_identifier, sizeof(char));
+    clr_conflicts = fill_parsetable(clr_parsetable, states, state_identifier,
+                                    clr_conflict_cells);
+
+    printf("CLR(1) states: %d\n", state_identifier);
+    printf("CLR(1) reduce/reduce conflicts: %d\n", clr_conflicts);
+
+    if (options->lalr)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_EXTERN;
-        node->token = token;
+        merged_index = malloc(sizeof(int) * state_identifier);
+        count = merge_states(&table_states, merged_index);
+
+        parsetable = calloc(NUM_SYMBOLS * count, sizeof(struct parsetable_item));
+        lalr_conflict_cells = calloc(NUM_SYMBOLS * count, sizeof(char));
+
+        printf("LALR(1) states: %d\n", count);
+        printf("LALR(1) reduce/reduce conflicts: %d\n",
+               fill_parsetable(parsetable, table_states, count,
+                               lalr_conflict_cells));
+        printf("LALR(1) new reduce/reduce conflicts: %d\n",
+               report_new_conflicts(clr_conflict_cells, lalr_conflict_cells,
+                                    merged_index, count));
+
+        free(clr_parsetable);
+        free(lalr_conflict_cells);
+        free(merged_index);
     }
-    else if (token->type == TOK_TYPEDEF)
+    else
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_TYPEDEF;
-        node->token = token;
+        parsetable = clr_parsetable;
     }
-    else if (token->type == TOK_GOTO)
+    free(clr_conflict_cells);
+
+    if (options->elide_unit_rules)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_GOTO;
-        node->token = token;
+        count = elide_unit_rules(count);
+        printf("States after eliding unit rules: %d\n", count);
     }
-    else if (token->type == TOK_CONTINUE)
+
+    write_parsetable(count, parsetable_key(options), options->elide_unit_rules);
+}
+#endif
+
+/*
+ * token_astnode_types maps each token type to the terminal it is parsed as.
+ * Entries are in the order of enum token_t, offset by one for TOK_EOF.
+ * TOK_EOF maps to AST_INVALID, the column of end of input, and tokens that
+ * aren't part of the grammar map to AST_UNKNOWN_TOKEN.
+ */
+static const enum astnode_t token_astnode_types[NUM_TOKENS] =
+{
+    AST_INVALID,                  /* TOK_EOF */
+    AST_INTEGER_CONSTANT,         /* TOK_INTEGER */
+    AST_STRING_CONSTANT,          /* TOK_STRING */
+    AST_IDENTIFIER,               /* TOK_IDENTIFIER */
+    AST_LPAREN,                   /* TOK_LPAREN */
+    AST_RPAREN,                   /* TOK_RPAREN */
+    AST_LBRACKET,                 /* TOK_LBRACKET */
+    AST_RBRACKET,                 /* TOK_RBRACKET */
+    AST_LBRACE,                   /* TOK_LBRACE */
+    AST_RBRACE,                   /* TOK_RBRACE */
+    AST_SEMICOLON,                /* TOK_SEMICOLON */
+    AST_EQUAL,                    /* TOK_EQUAL */
+    AST_BACKSLASH,                /* TOK_BACKSLASH */
+    AST_BACKSLASH_EQUAL,          /* TOK_BACKSLASH_EQUAL */
+    AST_MOD,                      /* TOK_MOD */
+    AST_MOD_EQUAL,                /* TOK_MOD_EQUAL */
+    AST_UNKNOWN_TOKEN,            /* TOK_BANG */
+    AST_PLUS,                     /* TOK_PLUS */
+    AST_PLUS_PLUS,                /* TOK_PLUS_PLUS */
+    AST_PLUS_EQUAL,               /* TOK_PLUS_EQUAL */
+    AST_MINUS,                    /* TOK_MINUS */
+    AST_MINUS_MINUS,              /* TOK_MINUS_MINUS */
+    AST_MINUS_EQUAL,              /* TOK_MINUS_EQUAL */
+    AST_ARROW,                    /* TOK_ARROW */
+    AST_ASTERISK,                 /* TOK_ASTERISK */
+    AST_ASTERISK_EQUAL,           /* TOK_ASTERISK_EQUAL */
+    AST_AMPERSAND,                /* TOK_AMPERSAND */
+    AST_AMPERSAND_AMPERSAND,      /* TOK_AMPERSAND_AMPERSAND */
+    AST_CARET,                    /* TOK_CARET */
+    AST_COMMA,                    /* TOK_COMMA */
+    AST_DOT,                      /* TOK_DOT */
+    AST_ELLIPSIS,                 /* TOK_ELLIPSIS */
+    AST_QUESTIONMARK,             /* TOK_QUESTIONMARK */
+    AST_COLON,                    /* TOK_COLON */
+    AST_VERTICALBAR,              /* TOK_VERTICALBAR */
+    AST_VERTICALBAR_VERTICALBAR,  /* TOK_VERTICALBAR_VERTICALBAR */
+    AST_UNKNOWN_TOKEN,            /* TOK_SINGLEQUOTE */
+    AST_SHIFTLEFT,                /* TOK_SHIFTLEFT */
+    AST_SHIFTRIGHT,               /* TOK_SHIFTRIGHT */
+    AST_LT,                       /* TOK_LESSTHAN */
+    AST_GT,                       /* TOK_GREATERTHAN */
+    AST_LTEQ,                     /* TOK_LESSTHANEQUAL */
+    AST_GTEQ,                     /* TOK_GREATERTHANEQUAL */
+    AST_EQ,                       /* TOK_EQ */
+    AST_NEQ,                      /* TOK_NEQ */
+    AST_UNKNOWN_TOKEN,            /* TOK_HASH */
+    AST_VOID,                     /* TOK_VOID */
+    AST_CHAR,                     /* TOK_CHAR */
+    AST_SHORT,                    /* TOK_SHORT */
+    AST_INT,                      /* TOK_INT */
+    AST_LONG,                     /* TOK_LONG */
+    AST_FLOAT,                    /* TOK_FLOAT */
+    AST_DOUBLE,                   /* TOK_DOUBLE */
+    AST_SIGNED,                   /* TOK_SIGNED */
+    AST_UNSIGNED,                 /* TOK_UNSIGNED */
+    AST_GOTO,                     /* TOK_GOTO */
+    AST_CONTINUE,                 /* TOK_CONTINUE */
+    AST_BREAK,                    /* TOK_BREAK */
+    AST_RETURN,                   /* TOK_RETURN */
+    AST_FOR,                      /* TOK_FOR */
+    AST_DO,                       /* TOK_DO */
+    AST_WHILE,                    /* TOK_WHILE */
+    AST_IF,                       /* TOK_IF */
+    AST_ELSE,                     /* TOK_ELSE */
+    AST_SWITCH,                   /* TOK_SWITCH */
+    AST_CASE,                     /* TOK_CASE */
+    AST_DEFAULT,                  /* TOK_DEFAULT */
+    AST_ENUM,                     /* TOK_ENUM */
+    AST_STRUCT,                   /* TOK_STRUCT */
+    AST_UNION,                    /* TOK_UNION */
+    AST_CONST,                    /* TOK_CONST */
+    AST_VOLATILE,                 /* TOK_VOLATILE */
+    AST_AUTO,                     /* TOK_AUTO */
+    AST_REGISTER,                 /* TOK_REGISTER */
+    AST_STATIC,                   /* TOK_STATIC */
+    AST_EXTERN,                   /* TOK_EXTERN */
+    AST_TYPEDEF,                  /* TOK_TYPEDEF */
+};
+
+struct astnode *
+token_to_astnode(struct token *token)
+{
+    struct astnode *node;
+
+    node = arena_alloc(sizeof(struct astnode));
+    node->type = token_astnode_types[token->type + 1];
+
+    /*
+     * The scanner reuses its token, so the node keeps its own copy. Only
+     * identifiers and constants are read by the AST, so other terminals
+     * don't keep one.
+     */
+    switch (node->type)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_CONTINUE;
-        node->token = token;
+        case AST_IDENTIFIER:
+        case AST_INTEGER_CONSTANT:
+        case AST_STRING_CONSTANT:
+        case AST_CHARACTER_CONSTANT:
+        {
+            node->token = arena_alloc(sizeof(struct token));
+            *node->token = *token;
+            break;
+        }
+        default:
+        {
+            node->token = NULL;
+            break;
+        }
     }
-    else if (token->type == TOK_BREAK)
+
+    return node;
+}
+
+#ifndef GENPT
+/*
+ * Returns whether an action leads to a state or rule that exists.
+ */
+static int
+action_valid(unsigned short action, int states)
+{
+    if (action & ACTION_SHIFT)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_BREAK;
-        node->token = token;
+        return ACTION_VALUE(action) < states;
     }
-    else if (token->type == TOK_RETURN)
+    if (action & ACTION_REDUCE)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_RETURN;
-        node->token = token;
+        return ACTION_VALUE(action) < NUM_RULES;
     }
-    else if (token->type == TOK_FOR)
+    return action == 0;
+}
+
+/*
+ * Returns whether every lookup in a packed parse table stays within its
+ * arrays and leads to a state or rule that exists.
+ */
+static int
+packed_parsetable_valid(const struct packed_parsetable *table,
+                        size_t action_size, size_t goto_size)
+{
+    size_t i;
+    int state;
+
+    for (state=0; state<table->states; state++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_FOR;
-        node->token = token;
+        if ((size_t)table->action_base[state] + NUM_TERMINALS > action_size ||
+            !action_valid(table->action_default[state], table->states))
+        {
+            return 0;
+        }
     }
-    else if (token->type == TOK_DO)
+
+    for (i=0; i<action_size; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_DO;
-        node->token = token;
+        if (!action_valid(table->action_value[i], table->states))
+        {
+            return 0;
+        }
     }
-    else if (token->type == TOK_WHILE)
+
+    for (i=0; i<NUM_NONTERMINALS; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_WHILE;
-        node->token = token;
+        if ((size_t)table->goto_base[i] + table->states > goto_size ||
+            table->goto_default[i] >= table->states)
+        {
+            return 0;
+        }
     }
-    else if (token->type == TOK_IF)
+
+    for (i=0; i<goto_size; i++)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_IF;
-        node->token = token;
+        if (table->goto_value[i] >= table->states)
+        {
+            return 0;
+        }
     }
-    else if (token->type == TOK_ELSE)
+
+    return 1;
+}
+
+/*
+ * Map a parse table file written by genpt and use it instead of the tables
+ * compiled in from parsetable.h. The file is mapped read-only and its arrays
+ * are used in place. Returns 0 on success, or -1 if the file can't be mapped,
+ * was generated for a different grammar or is corrupt, in which case the
+ * current tables are kept. A NULL filename goes back to the compiled tables.
+ */
+int
+load_parsetable(const char *filename)
+{
+    const struct parsetable_header *header;
+    const unsigned short *arrays;
+    struct packed_parsetable table;
+    struct stat st;
+    size_t size;
+    void *map;
+    int fd;
+
+    if (filename == NULL)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_ELSE;
-        node->token = token;
+        if (parsetable_map != NULL)
+        {
+            munmap(parsetable_map, parsetable_map_size);
+            parsetable_map = NULL;
+        }
+        parsetable = &compiled_parsetable;
+        return 0;
     }
-    else if (token->type == TOK_SWITCH)
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_SWITCH;
-        node->token = token;
+        return -1;
     }
-    else if (token->type == TOK_CASE)
+
+    if (fstat(fd, &st) < 0 ||
+        st.st_size < (off_t)sizeof(struct parsetable_header))
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_CASE;
-        node->token = token;
+        close(fd);
+        return -1;
     }
-    else if (token->type == TOK_DEFAULT)
+
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_DEFAULT;
-        node->token = token;
+        return -1;
     }
-    else if (token->type == TOK_ENUM)
+
+    header = map;
+    size = sizeof(struct parsetable_header) + sizeof(unsigned short) *
+        (2 * (size_t)header->states + 2 * (size_t)header->action_size +
+         2 * (size_t)header->nonterminals + 2 * (size_t)header->goto_size);
+
+    if (memcmp(header->magic, PARSETABLE_MAGIC, sizeof(PARSETABLE_MAGIC)) != 0 ||
+        header->version != PARSETABLE_VERSION ||
+        header->grammar_hash != grammar_hash() ||
+        header->terminals != NUM_TERMINALS ||
+        header->nonterminals != NUM_NONTERMINALS ||
+        header->rules != NUM_RULES ||
+        header->states == 0 || header->states > ACTION_MAX_VALUE ||
+        header->elided > 1 || (off_t)size != st.st_size)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_ENUM;
-        node->token = token;
+        munmap(map, st.st_size);
+        return -1;
     }
-    else if (token->type == TOK_STRUCT)
-    {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_STRUCT;
-        node->token = token;
+
+    arrays = (const unsigned short *)(header + 1);
+    table.states = header->states;
+    table.elided = header->elided;
+    table.action_default = arrays;
+    arrays += header->states;
+    table.action_base = arrays;
+    arrays += header->states;
+    table.action_check = arrays;
+    arrays += header->action_size;
+    table.action_value = arrays;
+    arrays += header->action_size;
+    table.goto_default = arrays;
+    arrays += header->nonterminals;
+    table.goto_base = arrays;
+    arrays += header->nonterminals;
+    table.goto_check = arrays;
+    arrays += header->goto_size;
+    table.goto_value = arrays;
+
+    if (!packed_parsetable_valid(&table, header->action_size,
+                                 header->goto_size))
+    {
+        munmap(map, st.st_size);
+        return -1;
     }
-    else if (token->type == TOK_UNION)
+
+    if (parsetable_map != NULL)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_UNION;
-        node->token = token;
+        munmap(parsetable_map, parsetable_map_size);
     }
-    else if (token->type == TOK_CONST)
+    parsetable_map = map;
+    parsetable_map_size = st.st_size;
+
+    mapped_parsetable = table;
+    parsetable = &mapped_parsetable;
+    return 0;
+}
+
+/*
+ * Returns the packed action for a terminal in a state.
+ */
+unsigned short
+parsetable_action(int state, enum astnode_t terminal)
+{
+    int i = parsetable->action_base[state] + INDEX(terminal);
+
+    if (parsetable->action_check[i] == state)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_CONST;
-        node->token = token;
+        return parsetable->action_value[i];
     }
-    else if (token->type == TOK_VOLATILE)
+    return parsetable->action_default[state];
+}
+
+/*
+ * Returns the state to go to after reducing a non-terminal in a state.
+ */
+int
+parsetable_goto(int state, enum astnode_t nonterminal)
+{
+    int column = INDEX(nonterminal) - NUM_TERMINALS;
+    int i = parsetable->goto_base[column] + state;
+
+    if (parsetable->goto_check[i] == column)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_VOLATILE;
-        node->token = token;
+        return parsetable->goto_value[i];
     }
-    else if (token->type == TOK_EOF)
+    return parsetable->goto_default[column];
+}
+
+/*
+ * parse_stack is a growable stack of states and the nodes pushed with them,
+ * kept in parallel arrays so that the nodes of a rule being reduced are
+ * contiguous. The bottom entry holds the start state and no node.
+ */
+struct parse_stack
+{
+    int *states;
+    struct astnode **nodes;
+    int size;
+    int capacity;
+};
+
+#define PARSE_STACK_INITIAL_CAPACITY 256
+
+static void
+push_stack(struct parse_stack *stack, int state, struct astnode *node)
+{
+    if (stack->size == stack->capacity)
     {
-        node = malloc(sizeof(struct astnode));
-        node->type = AST_INVALID;
-        node->token = token;
+        stack->capacity = stack->capacity ? stack->capacity * 2 :
+                          PARSE_STACK_INITIAL_CAPACITY;
+        stack->states = realloc(stack->states,
+                                sizeof(int) * stack->capacity);
+        stack->nodes = realloc(stack->nodes,
+                               sizeof(struct astnode *) * stack->capacity);
+        assert(stack->states != NULL && stack->nodes != NULL);
     }
 
-    return node;
+    stack->states[stack->size] = state;
+    stack->nodes[stack->size] = node;
+    stack->size++;
 }
 
 struct astnode *
-parse(struct listnode *tokens)
+parse(struct preprocessor *preprocessor)
 {
-    struct astnode *node, *root;
-    struct listnode *stack;
-    struct listnode *token;
-    struct parsetable_item *row, *cell;
-    static int zero = 0;
-    int i;
+    struct astnode *node, *root, *child;
+    struct parse_stack stack;
+    struct token *token;
+    struct rule *rule;
+    unsigned short action;
+    int state, i;
 
-    list_init(&stack);
+    memset(&stack, 0, sizeof(struct parse_stack));
+    root = NULL;
 
     /*
      * Stack starts at state 0.
      */
-    list_prepend(&stack, &zero);
+    push_stack(&stack, 0, NULL);
 
-    for (token=tokens; token!=NULL; )
+    /*
+     * node is the lookahead. It is converted once per token and reused by
+     * every reduction until the token is shifted.
+     */
+    token = preprocessor_next(preprocessor);
+    node = token_to_astnode(token);
+
+    for (;;)
     {
-        row = parsetable + *(int *)stack->data * NUM_SYMBOLS;
+        state = stack.states[stack.size - 1];
 
-        node = token_to_astnode((struct token *)token->data);
-        cell = row + INDEX(node->type);
-        if (cell->shift)
+        action = node->type == AST_UNKNOWN_TOKEN ? 0 :
+                 parsetable_action(state, node->type);
+        if (action & ACTION_SHIFT)
         {
             /*
              * Shift involves pushing node and state onto stack.
              */
-            list_prepend(&stack, node);
-            list_prepend(&stack, &cell->state);
+            push_stack(&stack, ACTION_VALUE(action), node);
 
             /*
-             * Consume a token
+             * Consume a token. The preprocessor keeps returning TOK_EOF once
+             * the content is exhausted, so stop if it has been shifted.
              */
-            token=token->next;
+            if (token->type == TOK_EOF)
+            {
+                break;
+            }
+            token = preprocessor_next(preprocessor);
+            node = token_to_astnode(token);
         }
-        else if (cell->reduce)
+        else if (action & ACTION_REDUCE)
         {
-            root = cell->rule->create(stack, cell->rule);
-
             /*
              * Reduce involves removing the astnodes that compose the rule from
              * the stack. Then create the reduced astnode and push it onto the
              * stack.
              */
-            for (i=0; i<cell->rule->length_of_nodes; i++)
+            rule = &grammar[ACTION_VALUE(action)];
+            stack.size -= rule->length_of_nodes;
+
+            /*
+             * A table generated with --elide-unit-rules skips the reductions
+             * of create_elided_node(), so a node may not have the type the
+             * rule expects yet. Give it the types those reductions would
+             * have.
+             */
+            if (parsetable->elided)
             {
-                /*
-                 * Remove astnode and cell state from the stack.
-                 */
-                stack = stack->next->next;
+                for (i=0; i<rule->length_of_nodes; i++)
+                {
+                    child = stack.nodes[stack.size + i];
+                    if (child->type != rule->nodes[i])
+                    {
+                        if (!child->elided_type)
+                        {
+                            child->elided_type = child->type;
+                        }
+                        child->type = rule->nodes[i];
+                    }
+                }
             }
 
+            root = rule->create(&stack.nodes[stack.size], rule);
+
             /*
              * Push the reduced node and the next state number.
              */
-            row = parsetable + *(int *)stack->data * NUM_SYMBOLS;
-            cell = row + INDEX(root->type);
-
-            list_prepend(&stack, root);
-            list_prepend(&stack, &cell->state);
+            state = parsetable_goto(stack.states[stack.size - 1], rule->type);
+            push_stack(&stack, state, root);
 
             /*
-             * Next iteration will use the cell->state, but should reuse the
-             * current input token. (Do not increment token->next)
+             * Next iteration will use the next state, but should reuse the
+             * current input token. (Do not increment token)
              */
         }
         else
         {
             /*
-             * We expect to be neither shift nor reduce iff this is the last
-             * token.
+             * Neither shift nor reduce at the end of input accepts once the
+             * whole input has been reduced to a translation unit. Otherwise
+             * the token can't follow the tokens before it.
              */
-            assert(token->next == NULL);
+            if (token->type == TOK_EOF && stack.size == 2 &&
+                stack.nodes[1]->type == AST_TRANSLATION_UNIT)
+            {
+                root = stack.nodes[1];
+                break;
+            }
+            else if (preprocessor->errors > 0)
+            {
+                /*
+                 * The preprocessor has reported why the input ended early.
+                 */
+            }
+            else if (token->type == TOK_EOF)
+            {
+                fprintf(stderr, "Syntax error: unexpected end of input\n");
+            }
+            else
+            {
+                fprintf(stderr, "Syntax error at offset %lu\n",
+                        (unsigned long)token->offset);
+            }
+            root = NULL;
             break;
         }
     }
 
-    return root;
+    free(stack.states);
+    free(stack.nodes);
+
+    /*
+     * The input may still reduce to a translation unit when the preprocessor
+     * stopped at an error.
+     */
+    return preprocessor->errors > 0 ? NULL : root;
 }
 
+#endif
+
 #ifdef GENPT
 int
-main(int argc, char *agv[])
+main(int argc, char *argv[])
 {
-    init_parsetable();
+    struct parsetable_options options;
+    char cached_header[PATH_MAX], cached_table[PATH_MAX];
+    const char *directory = NULL;
+    unsigned long key;
+    int i, use_cache = 1;
+
+    memset(&options, 0, sizeof(struct parsetable_options));
+
+    for (i=1; i<argc; i++)
+    {
+        if (strcmp(argv[i], "--lalr") == 0)
+        {
+            options.lalr = 1;
+        }
+        else if (strcmp(argv[i], "--threads") == 0)
+        {
+            options.threads = sysconf(_SC_NPROCESSORS_ONLN);
+        }
+        else if (strncmp(argv[i], "--threads=", 10) == 0)
+        {
+            options.threads = atoi(argv[i] + 10);
+        }
+        else if (strcmp(argv[i], "--elide-unit-rules") == 0)
+        {
+            options.elide_unit_rules = 1;
+        }
+        else if (strcmp(argv[i], "--no-cache") == 0)
+        {
+            use_cache = 0;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--lalr] [--elide-unit-rules] "
+                    "[--threads[=N]] [--no-cache]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    /*
+     * Nothing needs to be generated when the tables in the current directory
+     * or in the cache were generated from the same grammar by the same genpt
+     * with the same options. Without a hash of genpt there is no telling, so
+     * the tables are always generated.
+     */
+    generator_hash = file_hash("/proc/self/exe");
+    if (generator_hash == 0)
+    {
+        generator_hash = file_hash(argv[0]);
+    }
+    if (generator_hash == 0)
+    {
+        use_cache = 0;
+    }
+
+    key = parsetable_key(&options);
+
+    if (use_cache)
+    {
+        if (parsetable_current(key))
+        {
+            printf("Parse table is up to date\n");
+            return 0;
+        }
+
+        directory = cache_directory();
+    }
+
+    if (directory != NULL)
+    {
+        snprintf(cached_header, sizeof(cached_header),
+                 "%s/parsetable-%016lx.h", directory, key);
+        snprintf(cached_table, sizeof(cached_table),
+                 "%s/parsetable-%016lx.bin", directory, key);
+
+        if (copy_file(cached_header, "parsetable.h") == 0 &&
+            copy_file(cached_table, PARSETABLE_FILENAME) == 0 &&
+            parsetable_current(key))
+        {
+            printf("Parse table restored from %s\n", directory);
+            return 0;
+        }
+    }
+
+    init_parsetable(&options);
+
+    if (directory != NULL)
+    {
+        copy_file("parsetable.h", cached_header);
+        copy_file(PARSETABLE_FILENAME, cached_table);
+    }
+
+    return 0;
 }
 #endif
@@ -2,6 +2,7 @@
 #define __PARSER_H__
 
 #include "scanner.h"
+#include "preprocessor.h"
 
 enum astnode_t
 {
@@ -156,47 +157,96 @@ enum astnode_t
     AST_DECLARATION,
     AST_FUNCTION_DEFINITION,
     AST_EXTERNAL_DECLARATION,
-    AST_TRANSLATION_UNIT
+    AST_TRANSLATION_UNIT,
+
+    /*
+     * token that is not a terminal of the grammar. It follows every symbol,
+     * so no parse table has an action for it.
+     */
+    AST_UNKNOWN_TOKEN
 };
 
 
 #define MAX_ASTNODES 9
 
+/*
+ * Rules are reduced by their create function, which is passed the nodes of
+ * the rule in rule order: rhs[0] is the first node of the rule and
+ * rhs[length_of_nodes - 1] is the last.
+ */
 struct rule
 {
     enum astnode_t type;
-    struct astnode *(*create)(struct listnode *list, struct rule *rule);
+    struct astnode *(*create)(struct astnode **rhs, struct rule *rule);
     int length_of_nodes;
     enum astnode_t nodes[MAX_ASTNODES];
 };
 
 #define NUM_RULES 207
 
+#define NUM_TERMINALS (AST_INVALID - AST_CHARACTER_CONSTANT+ 1)
+#define NUM_SYMBOLS (AST_TRANSLATION_UNIT - AST_CHARACTER_CONSTANT + 1)
+#define INDEX(s) ((s) - AST_CHARACTER_CONSTANT)
+
+#define LOOKAHEAD_WORD_BITS 64
+#define LOOKAHEAD_WORDS \
+    ((NUM_TERMINALS + LOOKAHEAD_WORD_BITS - 1) / LOOKAHEAD_WORD_BITS)
+
 /*
- * item is a rule with a cursor position to indicate how many symbols have been
- * consumed.
+ * lookahead is a set of terminal symbols stored as a bitset. End of input
+ * (e.g. $) is stored as AST_INVALID since no terminal matches it.
  */
-struct item
+struct lookahead
+{
+    unsigned long long words[LOOKAHEAD_WORDS];
+};
+
+/*
+ * Item cores are a rule with a cursor position to indicate how many symbols
+ * have been consumed, interned as a dense integer. There is at most one core
+ * for each cursor position of each rule.
+ */
+#define MAX_CORES (NUM_RULES * (MAX_ASTNODES + 1))
+
+/*
+ * kernel is the set of items a state is identified by: the items reached by a
+ * transition into the state, or the start items of the root state. The
+ * closure items derived from them are not stored.
+ */
+struct kernel
 {
     /*
-     * rule that is being used.
+     * number of items in the kernel.
      */
-    struct rule *rewrite_rule;
+    int size;
 
     /*
-     * position into the rule.
+     * cores of the items, in increasing order.
      */
-    int cursor_position;
+    int *cores;
 
     /*
-     * list of lookahead symbols.
+     * set of lookahead symbols of each item.
      */
-    struct listnode *lookahead;
+    struct lookahead *lookaheads;
+
+    /*
+     * fingerprint is a hash of the items in the kernel. Kernels with
+     * identical items always have identical fingerprints.
+     */
+    unsigned long fingerprint;
 };
 
-#define NUM_TERMINALS (AST_INVALID - AST_CHARACTER_CONSTANT+ 1)
-#define NUM_SYMBOLS (AST_TRANSLATION_UNIT - AST_CHARACTER_CONSTANT + 1)
-#define INDEX(s) ((s) - AST_CHARACTER_CONSTANT)
+/*
+ * closure holds the items derived from a kernel. Every rule of a nonterminal
+ * the closure contains is an item with the cursor at the start and the
+ * lookahead of the nonterminal. Both arrays are indexed by INDEX().
+ */
+struct closure
+{
+    char contains[NUM_SYMBOLS];
+    struct lookahead lookaheads[NUM_SYMBOLS];
+};
 
 /*
  * state contains information of a set of items.
@@ -209,9 +259,9 @@ struct state
     int identifier;
 
     /*
-     * list of items in the state.
+     * kernel items of the state.
      */
-    struct listnode *items;
+    struct kernel kernel;
 
     /*
      * links maps symbol transitions to other states.
@@ -219,10 +269,21 @@ struct state
     struct state *links[NUM_SYMBOLS];
 };
 
-#define MAX_STATES 32768
+/*
+ * Number of states allocated at a time while the states of the grammar are
+ * generated.
+ */
+#define STATE_POOL_BLOCK_SIZE 256
+
+/*
+ * Initial size of the hash tables used to lookup existing states. It must be a
+ * power of two.
+ */
+#define STATE_TABLE_INITIAL_SIZE 1024
 
 /*
- * item inside a parse table row.
+ * item inside a row of the dense parse table that genpt builds before it is
+ * packed.
  */
 struct parsetable_item
 {
@@ -249,12 +310,141 @@ struct parsetable_item
     int state;
 };
 
+/*
+ * options that control how genpt constructs the parse table.
+ */
+struct parsetable_options
+{
+    /*
+     * lalr indicates whether states with identical cores are merged to build
+     * an LALR(1) table instead of the canonical CLR(1) table.
+     */
+    int lalr;
+
+    /*
+     * elide_unit_rules indicates whether the table is rewritten so that the
+     * parser skips reductions of rules created by create_elided_node(), which
+     * only pass their single node up with a new type.
+     */
+    int elide_unit_rules;
+
+    /*
+     * threads is the number of threads that generate states. Each frontier
+     * of new states is split between them, and the states are numbered the
+     * same whatever their number.
+     */
+    int threads;
+};
+
 void
-head_terminal_values(enum astnode_t node, struct listnode **checked_nodes,
-                     struct listnode **terminals);
+lookahead_add(struct lookahead *lookahead, enum astnode_t terminal);
+
+int
+lookahead_contains(const struct lookahead *lookahead, enum astnode_t terminal);
+
+void
+lookahead_union(struct lookahead *a, const struct lookahead *b);
+
+int
+lookahead_equal(const struct lookahead *a, const struct lookahead *b);
+
+unsigned long
+lookahead_hash(const struct lookahead *lookahead);
+
+unsigned long
+grammar_hash(void);
+
+/*
+ * Parse table actions are packed into 16 bits. The top two bits indicate a
+ * shift or a reduce and the remaining bits hold the state to shift to or the
+ * index of the rule to reduce. Zero is an error.
+ */
+#define ACTION_SHIFT 0x8000
+#define ACTION_REDUCE 0x4000
+#define ACTION_VALUE(action) ((action) & 0x3fff)
+#define ACTION_MAX_VALUE 0x3fff
+
+#define NUM_NONTERMINALS (NUM_SYMBOLS - NUM_TERMINALS)
+
+/*
+ * Marks unused entries of a packed table check array.
+ */
+#define PACKED_EMPTY 0xffff
+
+/*
+ * genpt also writes the packed tables to PARSETABLE_FILENAME so that a parser
+ * can use a regenerated table without being rebuilt. The file starts with a
+ * parsetable_header and is followed by the arrays of the ACTION table and then
+ * the GOTO table, each in the order default, base, check, value, as native
+ * unsigned shorts.
+ *
+ * grammar_hash is the grammar_hash() of the grammar the table was generated
+ * from and key also covers the options used to generate it. Both are written
+ * to parsetable.h as well. elided is set when the table was generated with
+ * --elide-unit-rules and so skips the reductions of create_elided_node().
+ */
+#define PARSETABLE_FILENAME "parsetable.bin"
+#define PARSETABLE_MAGIC "CLINKPT"
+#define PARSETABLE_VERSION 3
+
+struct parsetable_header
+{
+    char magic[8];
+    unsigned long long grammar_hash;
+    unsigned long long key;
+    unsigned int version;
+    unsigned int states;
+    unsigned int terminals;
+    unsigned int nonterminals;
+    unsigned int rules;
+    unsigned int action_size;
+    unsigned int goto_size;
+    unsigned int elided;
+};
+
+/*
+ * packed_parsetable points at the ACTION and GOTO tables used by the parser.
+ * See struct packed_table in parser.c for the layout of each table.
+ */
+struct packed_parsetable
+{
+    int states;
+    int elided;
+    const unsigned short *action_default;
+    const unsigned short *action_base;
+    const unsigned short *action_check;
+    const unsigned short *action_value;
+    const unsigned short *goto_default;
+    const unsigned short *goto_base;
+    const unsigned short *goto_check;
+    const unsigned short *goto_value;
+};
+
+const struct lookahead *
+first_set(enum astnode_t node);
+
+int
+symbol_nullable(enum astnode_t node);
 
 void
-generate_items(enum astnode_t node, struct listnode *lookahead, struct listnode **items);
+first_of_sequence(const enum astnode_t *nodes, int length,
+                  const struct lookahead *follow, struct lookahead *terminals);
+
+int
+item_core(struct rule *rule, int cursor_position);
+
+struct rule *
+core_rule(int core);
+
+int
+core_position(int core);
+
+void
+generate_closure(enum astnode_t node, const struct lookahead *lookahead,
+                 struct closure *closure);
+
+void
+kernel_closure(struct kernel *kernel, struct closure *closure);
 
 void
 generate_transitions(struct state *state);
@@ -263,21 +453,34 @@ struct state *
 generate_states(void);
 
 int
-state_contains_item(struct state *state, struct item *item);
+kernels_equal(struct kernel *a, struct kernel *b);
 
-int
-compare_states(struct state *a, struct state *b);
+unsigned long
+kernel_fingerprint(struct kernel *kernel);
 
 int
-index_of_state(struct state *state);
+index_of_state(struct kernel *kernel);
 
 void
-init_parsetable(void);
+init_parsetable(struct parsetable_options *options);
+
+int
+load_parsetable(const char *filename);
+
+unsigned short
+parsetable_action(int state, enum astnode_t terminal);
+
+int
+parsetable_goto(int state, enum astnode_t nonterminal);
 
 struct astnode *
 token_to_astnode(struct token * token);
 
+/*
+ * Returns the AST of the tokens of a preprocessor, or NULL after a syntax
+ * error or an error of the preprocessor has been reported.
+ */
 struct astnode *
-parse(struct listnode *tokens);
+parse(struct preprocessor *preprocessor);
 
 #endif
@@ -0,0 +1,512 @@
+/*
+ * Generated parse table file:
+ */
+#define PARSETABLE_GRAMMAR_HASH 0xffcf885f074da2caUL
+#define PARSETABLE_KEY 0xe76a4974fc3ad1baUL
+#define PARSETABLE_STATES 365
+#define PARSETABLE_ELIDED 0
+
+static const unsigned short parsetable_action_default[365] =
+{
+    0, 16451, 16458, 0, 16407, 16408, 16409, 16410, 16411, 16412, 16413, 16414, 16415, 0, 16424, 16425,
+    16419, 16420, 16402, 16403, 16404, 16405, 16406, 16418, 16400, 0, 16449, 0, 16417, 0, 16416, 16398,
+    16396, 0, 16387, 16386, 16384, 0, 16462, 16459, 16460, 0, 16442, 0, 16401, 16450, 0, 0,
+    0, 16388, 0, 0, 16394, 16423, 0, 16399, 16397, 16392, 16430, 16428, 0, 16385, 16463, 16461,
+    16452, 0, 16447, 16445, 0, 16471, 16455, 0, 16466, 16464, 0, 16470, 16590, 16589, 16585, 16583,
+    0, 0, 0, 0, 0, 0, 0, 16453, 16584, 16582, 16574, 16567, 16566, 16562, 16559, 16556,
+    16551, 16548, 16546, 16544, 16542, 16540, 16538, 0, 16536, 16583, 16501, 16503, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 16567, 16535, 16528, 0, 16497, 16496, 16495, 0, 16494,
+    16493, 16492, 16508, 0, 16430, 16390, 16395, 0, 0, 16435, 16439, 16437, 16426, 0, 0, 16433,
+    0, 16389, 0, 0, 16393, 0, 0, 0, 16443, 0, 16457, 0, 16456, 0, 0, 16481,
+    16469, 16480, 16468, 0, 16572, 16568, 16573, 16569, 16570, 16571, 0, 0, 16580, 16581, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 16454, 0, 0, 16523, 16524, 16525, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 16502, 16505, 16507, 16504, 0, 0, 16440,
+    16436, 0, 0, 0, 16421, 16427, 16434, 0, 16473, 16431, 16391, 16429, 16444, 16448, 16446, 16472,
+    16465, 16467, 16488, 0, 0, 16400, 16398, 16484, 0, 0, 0, 16482, 0, 16479, 16480, 16586,
+    16579, 16578, 16575, 0, 16587, 0, 16563, 16564, 16565, 16560, 16561, 16557, 16558, 16552, 16553, 16554,
+    16555, 16549, 16550, 16547, 16545, 16543, 16541, 0, 16539, 16498, 16522, 16526, 0, 0, 0, 0,
+    0, 0, 0, 16500, 16533, 16534, 16530, 16531, 16532, 16529, 16527, 16506, 16422, 16441, 16432, 16438,
+    0, 16476, 16483, 16490, 16486, 16489, 0, 16485, 0, 0, 16577, 16576, 0, 0, 0, 0,
+    0, 0, 0, 0, 16499, 0, 16474, 16491, 16487, 16588, 16537, 0, 0, 0, 0, 0,
+    0, 16512, 16509, 16511, 16475, 16477, 16514, 0, 0, 0, 0, 0, 0, 0, 0, 16517,
+    16516, 0, 16515, 0, 0, 0, 16513, 16510, 16520, 16519, 16518, 0, 16521,
+};
+
+static const unsigned short parsetable_action_base[365] =
+{
+    1323, 0, 160, 16, 0, 0, 0, 0, 0, 0, 0, 0, 0, 57, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 121, 12, 9, 1439, 0, 132, 0, 217,
+    281, 7, 0, 0, 0, 1372, 0, 164, 0, 12, 69, 1, 0, 230, 1383, 1901,
+    0, 0, 15, 1484, 0, 130, 1631, 0, 0, 0, 1428, 0, 255, 0, 0, 0,
+    0, 4, 136, 0, 61, 0, 0, 207, 0, 4, 206, 1643, 0, 0, 0, 0,
+    696, 760, 824, 888, 952, 1016, 1080, 0, 0, 0, 8, 0, 0, 83, 16, 68,
+    56, 75, 5, 6, 218, 241, 246, 241, 0, 254, 0, 0, 290, 289, 292, 1659,
+    317, 310, 331, 355, 376, 1144, 379, 75, 0, 0, 316, 0, 0, 0, 150, 0,
+    0, 0, 0, 75, 364, 0, 0, 1699, 1208, 505, 383, 0, 0, 1711, 1766, 569,
+    1920, 0, 1495, 197, 0, 277, 1272, 417, 0, 418, 0, 1527, 0, 171, 1934, 266,
+    0, 198, 0, 1755, 0, 0, 0, 0, 0, 0, 315, 419, 0, 0, 420, 1953,
+    2207, 2221, 2235, 2249, 2263, 2277, 2291, 2305, 2319, 2333, 2347, 2361, 2375, 2389, 2403, 2417,
+    2431, 2445, 2459, 2473, 0, 374, 399, 0, 0, 0, 319, 1981, 384, 2487, 2501, 2515,
+    421, 438, 2529, 2543, 2557, 2571, 2585, 2599, 2613, 0, 0, 0, 0, 246, 1806, 0,
+    0, 2627, 1817, 554, 0, 0, 0, 2008, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 421, 423, 345, 409, 0, 436, 1559, 2022, 294, 459, 0, 330, 0,
+    0, 0, 0, 343, 0, 368, 0, 0, 0, 498, 499, 149, 174, 195, 240, 262,
+    304, 71, 75, 319, 455, 450, 437, 360, 472, 0, 0, 0, 2041, 380, 462, 407,
+    443, 444, 534, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    165, 0, 0, 0, 0, 0, 489, 0, 488, 2641, 0, 0, 2655, 2068, 383, 2096,
+    2669, 598, 662, 726, 0, 1887, 0, 0, 0, 0, 0, 790, 471, 2123, 2151, 497,
+    547, 0, 458, 0, 0, 0, 0, 854, 918, 548, 982, 550, 2179, 496, 1046, 0,
+    0, 1110, 0, 1174, 1238, 558, 0, 0, 0, 0, 0, 1302, 0,
+};
+
+static const unsigned short parsetable_action_check[2745] =
+{
+    48, 48, 48, 48, 43, 48, 48, 65, 48, 48, 33, 48, 90, 48, 90, 25,
+    98, 90, 50, 3, 33, 94, 73, 99, 94, 48, 48, 90, 50, 3, 48, 48,
+    33, 33, 90, 26, 90, 26, 25, 41, 50, 50, 3, 48, 48, 48, 48, 48,
+    48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 13, 48, 48, 48,
+    48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 131, 131, 131, 131, 68,
+    131, 131, 119, 131, 131, 119, 131, 13, 131, 119, 68, 119, 96, 96, 96, 96,
+    93, 119, 93, 42, 131, 131, 95, 95, 93, 131, 131, 273, 273, 273, 273, 274,
+    274, 274, 274, 97, 97, 119, 131, 131, 131, 131, 131, 131, 131, 131, 131, 131,
+    131, 131, 131, 131, 131, 131, 131, 29, 131, 131, 131, 131, 131, 131, 131, 131,
+    131, 131, 131, 131, 131, 131, 126, 126, 126, 126, 267, 126, 126, 267, 126, 126,
+    53, 126, 29, 126, 24, 24, 24, 24, 24, 24, 24, 24, 24, 2, 157, 126,
+    126, 39, 66, 268, 126, 126, 268, 304, 157, 24, 24, 24, 24, 24, 24, 24,
+    24, 24, 24, 24, 304, 157, 157, 157, 147, 161, 126, 126, 126, 126, 126, 126,
+    126, 126, 147, 126, 126, 126, 157, 157, 157, 157, 157, 157, 157, 157, 157, 147,
+    161, 71, 161, 2, 2, 269, 269, 39, 39, 74, 71, 157, 157, 157, 157, 157,
+    157, 157, 157, 157, 157, 157, 221, 221, 221, 221, 100, 221, 221, 101, 221, 221,
+    45, 221, 45, 221, 31, 31, 31, 31, 31, 31, 31, 31, 31, 102, 103, 221,
+    221, 60, 270, 270, 221, 221, 105, 102, 60, 31, 31, 31, 31, 31, 31, 31,
+    31, 31, 31, 31, 159, 108, 159, 149, 271, 271, 221, 221, 221, 221, 221, 221,
+    221, 221, 149, 221, 221, 221, 113, 113, 113, 113, 109, 113, 113, 110, 113, 113,
+    251, 113, 251, 113, 32, 32, 32, 32, 32, 32, 32, 32, 32, 170, 122, 113,
+    113, 202, 272, 272, 113, 122, 170, 112, 202, 32, 32, 32, 32, 32, 32, 32,
+    32, 32, 32, 32, 254, 114, 254, 275, 275, 259, 113, 113, 113, 113, 113, 113,
+    113, 113, 259, 113, 113, 113, 197, 197, 197, 197, 279, 197, 197, 115, 197, 197,
+    279, 197, 261, 197, 245, 245, 245, 245, 245, 245, 245, 245, 245, 261, 285, 197,
+    197, 318, 116, 118, 197, 285, 132, 138, 318, 245, 245, 245, 245, 245, 245, 245,
+    245, 245, 245, 245, 151, 153, 171, 174, 198, 287, 197, 197, 197, 197, 197, 197,
+    197, 197, 287, 197, 197, 197, 209, 209, 209, 209, 204, 209, 209, 208, 209, 209,
+    243, 209, 244, 209, 246, 246, 246, 246, 246, 246, 246, 246, 246, 288, 289, 209,
+    209, 248, 276, 277, 209, 278, 288, 289, 252, 246, 246, 246, 246, 246, 246, 246,
+    246, 246, 246, 246, 280, 252, 252, 252, 286, 332, 209, 209, 209, 209, 209, 209,
+    209, 209, 332, 209, 209, 209, 252, 252, 252, 252, 252, 252, 252, 252, 252, 265,
+    266, 265, 266, 335, 310, 312, 338, 265, 266, 349, 335, 252, 252, 252, 252, 252,
+    252, 252, 252, 252, 252, 252, 290, 290, 290, 290, 65535, 290, 290, 65535, 290, 290,
+    65535, 290, 65535, 290, 137, 137, 137, 137, 137, 137, 137, 137, 137, 227, 65535, 290,
+    290, 65535, 65535, 65535, 290, 336, 345, 227, 347, 137, 137, 137, 137, 137, 336, 345,
+    357, 347, 227, 137, 227, 65535, 65535, 65535, 65535, 357, 290, 290, 290, 290, 290, 290,
+    290, 290, 65535, 290, 290, 290, 321, 321, 321, 321, 65535, 321, 321, 65535, 321, 321,
+    65535, 321, 65535, 321, 143, 143, 143, 143, 143, 143, 143, 143, 143, 65535, 65535, 321,
+    321, 65535, 65535, 65535, 321, 65535, 65535, 65535, 65535, 143, 143, 143, 143, 143, 65535, 65535,
+    65535, 65535, 65535, 143, 65535, 65535, 65535, 65535, 65535, 65535, 321, 321, 321, 321, 321, 321,
+    321, 321, 65535, 321, 321, 321, 322, 322, 322, 322, 65535, 322, 322, 65535, 322, 322,
+    65535, 322, 65535, 322, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 322,
+    322, 65535, 65535, 65535, 322, 65535, 65535, 65535, 80, 80, 80, 80, 65535, 80, 80, 65535,
+    80, 80, 65535, 80, 65535, 80, 65535, 65535, 65535, 65535, 322, 322, 322, 322, 322, 322,
+    322, 322, 80, 322, 322, 322, 323, 323, 323, 323, 65535, 323, 323, 65535, 323, 323,
+    65535, 323, 65535, 323, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 323,
+    323, 65535, 65535, 65535, 323, 65535, 65535, 65535, 81, 81, 81, 81, 65535, 81, 81, 65535,
+    81, 81, 65535, 81, 65535, 81, 65535, 65535, 65535, 65535, 323, 323, 323, 323, 323, 323,
+    323, 323, 81, 323, 323, 323, 331, 331, 331, 331, 65535, 331, 331, 65535, 331, 331,
+    65535, 331, 65535, 331, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 331,
+    331, 65535, 65535, 65535, 331, 65535, 65535, 65535, 82, 82, 82, 82, 65535, 82, 82, 65535,
+    82, 82, 65535, 82, 65535, 82, 65535, 65535, 65535, 65535, 331, 331, 331, 331, 331, 331,
+    331, 331, 82, 331, 331, 331, 343, 343, 343, 343, 65535, 343, 343, 65535, 343, 343,
+    65535, 343, 65535, 343, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 343,
+    343, 65535, 65535, 65535, 343, 65535, 65535, 65535, 83, 83, 83, 83, 65535, 83, 83, 65535,
+    83, 83, 65535, 83, 65535, 83, 65535, 65535, 65535, 65535, 343, 343, 343, 343, 343, 343,
+    343, 343, 83, 343, 343, 343, 344, 344, 344, 344, 65535, 344, 344, 65535, 344, 344,
+    65535, 344, 65535, 344, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 344,
+    344, 65535, 65535, 65535, 344, 65535, 65535, 65535, 84, 84, 84, 84, 65535, 84, 84, 65535,
+    84, 84, 65535, 84, 65535, 84, 65535, 65535, 65535, 65535, 344, 344, 344, 344, 344, 344,
+    344, 344, 84, 344, 344, 344, 346, 346, 346, 346, 65535, 346, 346, 65535, 346, 346,
+    65535, 346, 65535, 346, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 346,
+    346, 65535, 65535, 65535, 346, 65535, 65535, 65535, 85, 85, 85, 85, 65535, 85, 85, 65535,
+    85, 85, 65535, 85, 65535, 85, 65535, 65535, 65535, 65535, 346, 346, 346, 346, 346, 346,
+    346, 346, 85, 346, 346, 346, 350, 350, 350, 350, 65535, 350, 350, 65535, 350, 350,
+    65535, 350, 65535, 350, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 350,
+    350, 65535, 65535, 65535, 350, 65535, 65535, 65535, 86, 86, 86, 86, 65535, 86, 86, 65535,
+    86, 86, 65535, 86, 65535, 86, 65535, 65535, 65535, 65535, 350, 350, 350, 350, 350, 350,
+    350, 350, 86, 350, 350, 350, 353, 353, 353, 353, 65535, 353, 353, 65535, 353, 353,
+    65535, 353, 65535, 353, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 353,
+    353, 65535, 65535, 65535, 353, 65535, 65535, 65535, 117, 117, 117, 117, 65535, 117, 117, 65535,
+    117, 117, 65535, 117, 65535, 117, 65535, 65535, 65535, 65535, 353, 353, 353, 353, 353, 353,
+    353, 353, 117, 353, 353, 353, 355, 355, 355, 355, 65535, 355, 355, 65535, 355, 355,
+    65535, 355, 65535, 355, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 355,
+    355, 65535, 65535, 65535, 355, 65535, 65535, 65535, 136, 136, 136, 136, 65535, 136, 136, 65535,
+    136, 136, 65535, 136, 65535, 136, 65535, 65535, 65535, 65535, 355, 355, 355, 355, 355, 355,
+    355, 355, 136, 355, 355, 355, 356, 356, 356, 356, 65535, 356, 356, 65535, 356, 356,
+    65535, 356, 65535, 356, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 356,
+    356, 65535, 65535, 65535, 356, 65535, 65535, 65535, 150, 150, 150, 150, 65535, 150, 150, 65535,
+    150, 150, 65535, 150, 65535, 150, 65535, 65535, 65535, 65535, 356, 356, 356, 356, 356, 356,
+    356, 356, 150, 356, 356, 356, 363, 363, 363, 363, 65535, 363, 363, 65535, 363, 363,
+    65535, 363, 65535, 363, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 0, 363,
+    363, 65535, 65535, 65535, 363, 65535, 65535, 65535, 0, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 0, 65535, 65535, 65535, 65535, 363, 363, 363, 363, 363, 363,
+    363, 363, 65535, 363, 363, 363, 0, 0, 0, 0, 0, 0, 0, 0, 0, 37,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 37, 46, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 37, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 46, 65535, 65535, 65535, 65535, 37, 37, 37, 37, 37, 37, 37, 37, 37,
+    65535, 65535, 46, 46, 46, 46, 46, 46, 46, 46, 46, 65535, 37, 37, 37, 37,
+    37, 37, 37, 37, 37, 37, 37, 46, 46, 46, 46, 46, 46, 46, 46, 46,
+    46, 46, 58, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 27, 58, 58,
+    58, 58, 58, 58, 58, 58, 58, 58, 65535, 65535, 27, 27, 27, 27, 27, 27,
+    27, 27, 27, 65535, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 27,
+    27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 51, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 146, 65535, 51, 51, 51, 51, 51, 51, 51, 51, 51,
+    65535, 65535, 146, 146, 146, 146, 146, 146, 146, 146, 146, 155, 51, 51, 51, 51,
+    51, 51, 51, 51, 51, 51, 51, 146, 146, 146, 146, 146, 146, 146, 146, 146,
+    146, 146, 155, 155, 155, 155, 155, 155, 155, 155, 155, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 249, 65535, 65535, 65535, 65535, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+    155, 155, 249, 249, 249, 249, 249, 249, 249, 249, 249, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 249, 249, 249, 249, 249, 249, 249, 249, 249,
+    249, 249, 54, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 54, 65535, 75, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 54, 75, 54, 65535, 111, 111, 111, 111, 65535,
+    111, 111, 65535, 111, 111, 75, 111, 75, 111, 65535, 54, 54, 54, 54, 54, 54,
+    54, 54, 54, 65535, 111, 111, 75, 75, 75, 75, 75, 75, 75, 75, 75, 54,
+    54, 54, 54, 54, 65535, 65535, 135, 65535, 65535, 54, 65535, 75, 75, 75, 75, 75,
+    135, 65535, 141, 65535, 65535, 75, 65535, 65535, 65535, 65535, 65535, 135, 141, 135, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 141, 65535, 141, 65535, 65535, 65535, 65535, 135, 135,
+    135, 135, 135, 135, 135, 135, 135, 65535, 65535, 65535, 141, 141, 141, 141, 141, 141,
+    141, 141, 141, 135, 135, 135, 135, 135, 163, 65535, 65535, 65535, 65535, 135, 65535, 141,
+    141, 141, 141, 141, 65535, 163, 65535, 163, 142, 141, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 142, 163, 163, 163, 163, 163, 163, 163, 163, 163, 65535,
+    65535, 142, 142, 142, 142, 142, 142, 142, 142, 142, 65535, 163, 163, 163, 163, 163,
+    222, 65535, 65535, 65535, 65535, 163, 142, 142, 142, 142, 142, 226, 65535, 222, 65535, 65535,
+    142, 65535, 226, 65535, 65535, 65535, 65535, 65535, 65535, 222, 222, 222, 222, 222, 222, 222,
+    222, 222, 65535, 65535, 226, 226, 226, 226, 226, 226, 226, 226, 226, 65535, 222, 222,
+    222, 222, 222, 65535, 65535, 65535, 65535, 65535, 222, 226, 226, 226, 226, 226, 65535, 325,
+    325, 325, 325, 226, 325, 325, 65535, 325, 325, 65535, 325, 65535, 325, 47, 47, 47,
+    47, 65535, 47, 47, 65535, 47, 47, 65535, 47, 325, 47, 65535, 65535, 325, 325, 65535,
+    144, 144, 144, 144, 65535, 144, 144, 47, 144, 144, 47, 144, 65535, 144, 158, 158,
+    158, 158, 65535, 158, 158, 65535, 158, 158, 65535, 158, 144, 158, 65535, 65535, 144, 65535,
+    65535, 175, 175, 175, 175, 65535, 175, 175, 158, 175, 175, 158, 175, 65535, 175, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 175, 175, 203, 203, 203,
+    203, 65535, 203, 203, 65535, 203, 203, 65535, 203, 65535, 203, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 203, 203, 231, 231, 231, 231, 65535, 231, 231, 65535,
+    231, 231, 65535, 231, 65535, 231, 250, 250, 250, 250, 65535, 250, 250, 65535, 250, 250,
+    65535, 250, 231, 250, 65535, 65535, 231, 65535, 65535, 284, 284, 284, 284, 65535, 284, 284,
+    250, 284, 284, 250, 284, 65535, 284, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 284, 284, 317, 317, 317, 317, 65535, 317, 317, 65535, 317, 317, 65535, 317,
+    65535, 317, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 317, 317,
+    319, 319, 319, 319, 65535, 319, 319, 65535, 319, 319, 65535, 319, 65535, 319, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 319, 319, 333, 333, 333, 333, 65535,
+    333, 333, 65535, 333, 333, 65535, 333, 65535, 333, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 333, 333, 334, 334, 334, 334, 65535, 334, 334, 65535, 334,
+    334, 65535, 334, 65535, 334, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 334, 334, 348, 348, 348, 348, 65535, 348, 348, 65535, 348, 348, 65535, 348, 65535,
+    348, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 348, 348, 176,
+    176, 176, 176, 65535, 176, 176, 65535, 176, 176, 65535, 176, 65535, 176, 177, 177, 177,
+    177, 65535, 177, 177, 65535, 177, 177, 65535, 177, 176, 177, 178, 178, 178, 178, 65535,
+    178, 178, 65535, 178, 178, 65535, 178, 177, 178, 179, 179, 179, 179, 65535, 179, 179,
+    65535, 179, 179, 65535, 179, 178, 179, 180, 180, 180, 180, 65535, 180, 180, 65535, 180,
+    180, 65535, 180, 179, 180, 181, 181, 181, 181, 65535, 181, 181, 65535, 181, 181, 65535,
+    181, 180, 181, 182, 182, 182, 182, 65535, 182, 182, 65535, 182, 182, 65535, 182, 181,
+    182, 183, 183, 183, 183, 65535, 183, 183, 65535, 183, 183, 65535, 183, 182, 183, 184,
+    184, 184, 184, 65535, 184, 184, 65535, 184, 184, 65535, 184, 183, 184, 185, 185, 185,
+    185, 65535, 185, 185, 65535, 185, 185, 65535, 185, 184, 185, 186, 186, 186, 186, 65535,
+    186, 186, 65535, 186, 186, 65535, 186, 185, 186, 187, 187, 187, 187, 65535, 187, 187,
+    65535, 187, 187, 65535, 187, 186, 187, 188, 188, 188, 188, 65535, 188, 188, 65535, 188,
+    188, 65535, 188, 187, 188, 189, 189, 189, 189, 65535, 189, 189, 65535, 189, 189, 65535,
+    189, 188, 189, 190, 190, 190, 190, 65535, 190, 190, 65535, 190, 190, 65535, 190, 189,
+    190, 191, 191, 191, 191, 65535, 191, 191, 65535, 191, 191, 65535, 191, 190, 191, 192,
+    192, 192, 192, 65535, 192, 192, 65535, 192, 192, 65535, 192, 191, 192, 193, 193, 193,
+    193, 65535, 193, 193, 65535, 193, 193, 65535, 193, 192, 193, 194, 194, 194, 194, 65535,
+    194, 194, 65535, 194, 194, 65535, 194, 193, 194, 195, 195, 195, 195, 65535, 195, 195,
+    65535, 195, 195, 65535, 195, 194, 195, 205, 205, 205, 205, 65535, 205, 205, 65535, 205,
+    205, 65535, 205, 195, 205, 206, 206, 206, 206, 65535, 206, 206, 65535, 206, 206, 65535,
+    206, 205, 206, 207, 207, 207, 207, 65535, 207, 207, 65535, 207, 207, 65535, 207, 206,
+    207, 210, 210, 210, 210, 65535, 210, 210, 65535, 210, 210, 65535, 210, 207, 210, 211,
+    211, 211, 211, 65535, 211, 211, 65535, 211, 211, 65535, 211, 210, 211, 212, 212, 212,
+    212, 65535, 212, 212, 65535, 212, 212, 65535, 212, 211, 212, 213, 213, 213, 213, 65535,
+    213, 213, 65535, 213, 213, 65535, 213, 212, 213, 214, 214, 214, 214, 65535, 214, 214,
+    65535, 214, 214, 65535, 214, 213, 214, 215, 215, 215, 215, 65535, 215, 215, 65535, 215,
+    215, 65535, 215, 214, 215, 216, 216, 216, 216, 65535, 216, 216, 65535, 216, 216, 65535,
+    216, 215, 216, 225, 225, 225, 225, 65535, 225, 225, 65535, 225, 225, 65535, 225, 216,
+    225, 313, 313, 313, 313, 65535, 313, 313, 65535, 313, 313, 65535, 313, 225, 313, 316,
+    316, 316, 316, 65535, 316, 316, 65535, 316, 316, 65535, 316, 313, 316, 320, 320, 320,
+    320, 65535, 320, 320, 65535, 320, 320, 65535, 320, 316, 320, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 320, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+};
+
+static const unsigned short parsetable_action_value[2745] =
+{
+    32844, 32845, 32846, 32873, 32834, 32848, 32849, 32834, 32850, 32851, 32769, 32852, 32939, 32853, 32940, 32769,
+    32958, 32941, 32769, 32769, 32770, 32948, 32923, 32959, 32949, 32874, 32854, 32942, 32770, 32770, 32816, 32875,
+    32825, 32771, 32943, 32814, 32944, 32815, 32771, 32832, 32825, 32771, 32771, 32772, 32773, 32774, 32775, 32776,
+    32777, 32778, 32779, 32780, 32876, 32877, 32878, 32879, 32880, 32881, 32882, 32883, 32810, 32884, 32885, 32886,
+    32781, 32782, 32783, 32784, 32785, 32786, 32787, 32788, 32789, 32790, 32791, 32844, 32845, 32846, 32873, 32919,
+    32848, 32849, 32978, 32850, 32851, 32979, 32852, 32811, 32853, 32980, 32920, 32981, 32952, 32953, 32954, 32955,
+    32945, 32982, 32946, 32833, 32874, 32854, 32950, 32951, 32947, 32816, 32988, 32952, 32953, 32954, 32955, 32952,
+    32953, 32954, 32955, 32956, 32957, 32983, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 32876,
+    32877, 32878, 32879, 32880, 32881, 32882, 32883, 32821, 32884, 32885, 32886, 32781, 32782, 32783, 32784, 32785,
+    32786, 32787, 32788, 32789, 32790, 32791, 32844, 32845, 32846, 32873, 32948, 32848, 32849, 32949, 32850, 32851,
+    32903, 32852, 32822, 32853, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 32770, 32769, 32874,
+    32854, 32770, 32918, 32948, 32816, 32986, 32949, 33093, 32770, 32781, 32782, 32783, 32784, 32785, 32786, 32787,
+    32788, 32789, 32790, 32791, 33094, 32925, 33010, 32926, 32769, 32769, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 32770, 32884, 32885, 32886, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 32771,
+    32925, 32921, 32926, 32784, 32785, 32950, 32951, 32784, 32785, 32924, 32922, 32781, 32782, 32783, 32784, 32785,
+    32786, 32787, 32788, 32789, 32790, 32791, 32844, 32845, 32846, 32873, 32960, 32848, 32849, 32961, 32850, 32851,
+    32814, 32852, 32815, 32853, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 32962, 32964, 32874,
+    32854, 32915, 32950, 32951, 32816, 33067, 32965, 32963, 32916, 32781, 32782, 32783, 32784, 32785, 32786, 32787,
+    32788, 32789, 32790, 32791, 33017, 32966, 33018, 32919, 32950, 32951, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 33004, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 32967, 32848, 32849, 32968, 32850, 32851,
+    33017, 32852, 33018, 32853, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 32984, 32984, 32874,
+    32854, 32984, 32950, 32951, 32816, 32985, 33023, 32971, 33051, 32781, 32782, 32783, 32784, 32785, 32786, 32787,
+    32788, 32789, 32790, 32791, 33020, 32973, 32926, 32956, 32957, 33081, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 33082, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 32984, 32848, 32849, 32974, 32850, 32851,
+    33084, 32852, 32984, 32853, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 33083, 32984, 32874,
+    32854, 32984, 32975, 32977, 32816, 33087, 32912, 32993, 33101, 32781, 32782, 32783, 32784, 32785, 32786, 32787,
+    32788, 32789, 32790, 32791, 32834, 33007, 33024, 33025, 33050, 32984, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 33089, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 33054, 32848, 32849, 33058, 32850, 32851,
+    33074, 32852, 33075, 32853, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 32984, 32984, 32874,
+    32854, 33076, 32958, 32959, 32816, 32960, 33090, 33091, 32770, 32781, 32782, 32783, 32784, 32785, 32786, 32787,
+    32788, 32789, 32790, 32791, 32961, 33020, 33010, 32926, 33088, 32984, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 33111, 32884, 32885, 32886, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 32945,
+    32945, 32946, 32946, 32984, 33095, 33096, 33118, 32947, 32947, 33126, 33116, 32781, 32782, 32783, 32784, 32785,
+    32786, 32787, 32788, 32789, 32790, 32791, 32844, 32845, 32846, 32873, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 0, 32853, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 32769, 0, 32874,
+    32854, 0, 0, 0, 32816, 32984, 32984, 32770, 32984, 32781, 32782, 32783, 32784, 32785, 33117, 33121,
+    32984, 33123, 32904, 32791, 32771, 0, 0, 0, 0, 33131, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 0, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 0, 32853, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 0, 0, 32874,
+    32854, 0, 0, 0, 32816, 0, 0, 0, 0, 32781, 32782, 32783, 32784, 32785, 0, 0,
+    0, 0, 0, 32791, 0, 0, 0, 0, 0, 0, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 0, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32874,
+    32854, 0, 0, 0, 32816, 0, 0, 0, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0,
+    32850, 32851, 0, 32852, 0, 32853, 0, 0, 0, 0, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 32854, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32874,
+    32854, 0, 0, 0, 32816, 0, 0, 0, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0,
+    32850, 32851, 0, 32852, 0, 32853, 0, 0, 0, 0, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 32854, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32874,
+    32854, 0, 0, 0, 32816, 0, 0, 0, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0,
+    32850, 32851, 0, 32852, 0, 32853, 0, 0, 0, 0, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 32854, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32874,
+    32854, 0, 0, 0, 32816, 0, 0, 0, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0,
+    32850, 32851, 0, 32852, 0, 32853, 0, 0, 0, 0, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 32854, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32874,
+    32854, 0, 0, 0, 32816, 0, 0, 0, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0,
+    32850, 32851, 0, 32852, 0, 32853, 0, 0, 0, 0, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 32854, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32874,
+    32854, 0, 0, 0, 32816, 0, 0, 0, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0,
+    32850, 32851, 0, 32852, 0, 32853, 0, 0, 0, 0, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 32854, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32874,
+    32854, 0, 0, 0, 32816, 0, 0, 0, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0,
+    32850, 32851, 0, 32852, 0, 32853, 0, 0, 0, 0, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 32854, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32874,
+    32854, 0, 0, 0, 32816, 0, 0, 0, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0,
+    32850, 32851, 0, 32852, 0, 32853, 0, 0, 0, 0, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 32854, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32874,
+    32854, 0, 0, 0, 32816, 0, 0, 0, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0,
+    32850, 32851, 0, 32852, 0, 32853, 0, 0, 0, 0, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 32854, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32874,
+    32854, 0, 0, 0, 32816, 0, 0, 0, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0,
+    32850, 32851, 0, 32852, 0, 32853, 0, 0, 0, 0, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 32854, 32884, 32885, 32886, 32844, 32845, 32846, 32873, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32769, 32874,
+    32854, 0, 0, 0, 32816, 0, 0, 0, 32770, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 32771, 0, 0, 0, 0, 32876, 32877, 32878, 32879, 32880, 32881,
+    32882, 32883, 0, 32884, 32885, 32886, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 32769,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 32770, 32837, 32781, 32782, 32783, 32784, 32785,
+    32786, 32787, 32788, 32789, 32790, 32791, 32771, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 32838, 0, 0, 0, 0, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780,
+    0, 0, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 0, 32781, 32782, 32783, 32784,
+    32785, 32786, 32787, 32788, 32789, 32790, 32791, 32781, 32782, 32783, 32784, 32785, 32786, 32787, 32788, 32789,
+    32790, 32791, 32816, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32816, 32912, 32772,
+    32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 0, 0, 32772, 32773, 32774, 32775, 32776, 32777,
+    32778, 32779, 32780, 0, 32781, 32782, 32783, 32784, 32785, 32786, 32787, 32788, 32789, 32790, 32791, 32781,
+    32782, 32783, 32784, 32785, 32786, 32787, 32788, 32789, 32790, 32791, 32816, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 32816, 0, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780,
+    0, 0, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 33008, 32781, 32782, 32783, 32784,
+    32785, 32786, 32787, 32788, 32789, 32790, 32791, 32781, 32782, 32783, 32784, 32785, 32786, 32787, 32788, 32789,
+    32790, 32791, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 0, 0, 0, 0, 0,
+    0, 0, 33077, 0, 0, 0, 0, 32781, 32782, 32783, 32784, 32785, 32786, 32787, 32788, 32789,
+    32790, 32791, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 32781, 32782, 32783, 32784, 32785, 32786, 32787, 32788, 32789,
+    32790, 32791, 32769, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32770, 0, 32769, 0,
+    0, 0, 0, 0, 0, 0, 0, 32904, 32770, 32771, 0, 32844, 32845, 32846, 32847, 0,
+    32848, 32849, 0, 32850, 32851, 32925, 32852, 32926, 32853, 0, 32772, 32773, 32774, 32775, 32776, 32777,
+    32778, 32779, 32780, 0, 32969, 32854, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 32781,
+    32782, 32783, 32784, 32785, 0, 0, 32769, 0, 0, 32791, 0, 32781, 32782, 32783, 32784, 32785,
+    32770, 0, 32769, 0, 0, 32791, 0, 0, 0, 0, 0, 32904, 32770, 32771, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 32904, 0, 32771, 0, 0, 0, 0, 32772, 32773,
+    32774, 32775, 32776, 32777, 32778, 32779, 32780, 0, 0, 0, 32772, 32773, 32774, 32775, 32776, 32777,
+    32778, 32779, 32780, 32781, 32782, 32783, 32784, 32785, 32770, 0, 0, 0, 0, 32791, 0, 32781,
+    32782, 32783, 32784, 32785, 0, 33020, 0, 32926, 32995, 32791, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 32996, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 0,
+    0, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 0, 32781, 32782, 32783, 32784, 32785,
+    32995, 0, 0, 0, 0, 32791, 32781, 32782, 32783, 32784, 32785, 32995, 0, 33068, 0, 0,
+    32791, 0, 33070, 0, 0, 0, 0, 0, 0, 32772, 32773, 32774, 32775, 32776, 32777, 32778,
+    32779, 32780, 0, 0, 32772, 32773, 32774, 32775, 32776, 32777, 32778, 32779, 32780, 0, 32781, 32782,
+    32783, 32784, 32785, 0, 0, 0, 0, 0, 32791, 32781, 32782, 32783, 32784, 32785, 0, 32844,
+    32845, 32846, 32847, 32791, 32848, 32849, 0, 32850, 32851, 0, 32852, 0, 32853, 32844, 32845, 32846,
+    32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 0, 0, 32999, 33108, 0,
+    32844, 32845, 32846, 32847, 0, 32848, 32849, 32854, 32850, 32851, 32855, 32852, 0, 32853, 32844, 32845,
+    32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 0, 0, 32999, 0,
+    0, 32844, 32845, 32846, 32847, 0, 32848, 32849, 32854, 32850, 32851, 33015, 32852, 0, 32853, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32854, 33026, 32844, 32845, 32846,
+    32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 0, 32853, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 33052, 32854, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0,
+    32850, 32851, 0, 32852, 0, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851,
+    0, 32852, 32854, 32853, 0, 0, 32999, 0, 0, 32844, 32845, 32846, 32847, 0, 32848, 32849,
+    32854, 32850, 32851, 33079, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 33085, 32854, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852,
+    0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32854, 33099,
+    32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 0, 32853, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 33102, 32854, 32844, 32845, 32846, 32847, 0,
+    32848, 32849, 0, 32850, 32851, 0, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 32854, 33112, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850,
+    32851, 0, 32852, 0, 32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 32854, 33114, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 0,
+    32853, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32854, 33124, 32844,
+    32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 0, 32853, 32844, 32845, 32846,
+    32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0,
+    32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849,
+    0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850,
+    32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0,
+    32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854,
+    32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844,
+    32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846,
+    32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0,
+    32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849,
+    0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850,
+    32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0,
+    32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854,
+    32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844,
+    32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846,
+    32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0,
+    32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849,
+    0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850,
+    32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0,
+    32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854,
+    32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844,
+    32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846,
+    32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0,
+    32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849,
+    0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850,
+    32851, 0, 32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0,
+    32852, 32854, 32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854,
+    32853, 32844, 32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844,
+    32845, 32846, 32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 32844, 32845, 32846,
+    32847, 0, 32848, 32849, 0, 32850, 32851, 0, 32852, 32854, 32853, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 32854, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const unsigned short parsetable_goto_default[63] =
+{
+    88, 259, 89, 90, 119, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102,
+    103, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130, 159, 243, 0, 304,
+    233, 71, 72, 73, 244, 24, 39, 25, 26, 138, 67, 68, 28, 139, 0, 0,
+    140, 141, 59, 60, 142, 29, 30, 31, 32, 50, 51, 52, 35, 36, 37,
+};
+
+static const unsigned short parsetable_goto_base[63] =
+{
+    0, 0, 0, 0, 0, 23, 32, 49, 33, 53, 8, 13, 16, 17, 19, 0,
+    79, 10, 55, 0, 0, 0, 0, 0, 2, 0, 0, 0, 5, 1, 0, 0,
+    2, 0, 1, 0, 0, 0, 0, 2, 0, 15, 0, 2, 0, 0, 0, 0,
+    2, 136, 23, 0, 4, 0, 0, 12, 0, 216, 1, 21, 0, 0, 0,
+};
+
+static const unsigned short parsetable_goto_check[581] =
+{
+    65535, 65535, 37, 65535, 39, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 41,
+    65535, 65535, 41, 65535, 65535, 59, 65535, 65535, 65535, 40, 65535, 65535, 65535, 24, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 61, 65535, 37, 65535, 39, 65535, 65535, 65535, 65535, 36, 4,
+    41, 58, 65535, 65535, 41, 24, 37, 65535, 65535, 17, 59, 58, 24, 65535, 65535, 65535,
+    65535, 41, 55, 43, 65535, 65535, 65535, 65535, 59, 65535, 65535, 37, 29, 39, 65535, 65535,
+    4, 4, 4, 4, 4, 4, 19, 55, 65535, 65535, 41, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 5, 65535, 5, 65535, 5, 5, 65535, 65535, 19,
+    65535, 27, 65535, 65535, 65535, 4, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 27, 17,
+    65535, 65535, 65535, 23, 65535, 65535, 65535, 37, 4, 37, 65535, 52, 65535, 37, 37, 37,
+    48, 52, 17, 55, 24, 55, 4, 42, 59, 55, 55, 55, 34, 37, 4, 39,
+    17, 40, 41, 37, 29, 39, 28, 59, 17, 55, 50, 65535, 41, 65535, 65535, 55,
+    19, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 19, 4, 16, 27, 10, 18, 5, 5, 5, 19, 11, 19, 19, 19,
+    12, 27, 13, 49, 6, 6, 14, 16, 57, 8, 8, 8, 8, 27, 37, 65535,
+    48, 4, 37, 45, 48, 16, 18, 7, 7, 32, 55, 17, 65535, 16, 55, 65535,
+    57, 9, 9, 65535, 65535, 37, 37, 57, 57, 36, 4, 65535, 37, 57, 39, 65535,
+    65535, 55, 55, 28, 17, 65535, 57, 65535, 55, 18, 18, 18, 18, 18, 18, 18,
+    65535, 49, 65535, 65535, 65535, 65535, 65535, 49, 65535, 65535, 65535, 65535, 19, 65535, 18, 65535,
+    65535, 65535, 27, 65535, 65535, 49, 65535, 65535, 65535, 65535, 65535, 49, 65535, 65535, 65535, 65535,
+    16, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 4, 19, 65535, 19,
+    19, 27, 27, 27, 65535, 65535, 17, 32, 65535, 16, 65535, 27, 65535, 19, 19, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 27, 27, 65535, 27, 65535, 19, 65535, 27, 65535,
+    65535, 27, 65535, 27, 27, 65535, 65535, 65535, 65535, 65535, 65535, 27, 65535, 65535, 65535, 65535,
+    18, 65535, 65535, 57, 65535, 57, 65535, 65535, 65535, 65535, 65535, 65535, 18, 49, 49, 65535,
+    65535, 65535, 65535, 65535, 49, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 57, 57, 65535,
+    65535, 57, 65535, 65535, 57, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535, 65535, 65535,
+};
+
+static const unsigned short parsetable_goto_value[581] =
+{
+    0, 0, 38, 0, 40, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 27,
+    0, 0, 41, 0, 0, 34, 0, 0, 0, 45, 0, 0, 0, 49, 0, 0,
+    0, 0, 0, 0, 0, 61, 0, 62, 0, 63, 0, 0, 0, 0, 74, 91,
+    58, 131, 0, 0, 27, 133, 137, 0, 0, 104, 34, 146, 145, 0, 0, 0,
+    0, 132, 143, 149, 0, 0, 0, 0, 134, 0, 0, 137, 160, 161, 0, 0,
+    91, 165, 91, 167, 91, 91, 170, 143, 0, 0, 162, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 164, 0, 166, 0, 168, 169, 0, 0, 202,
+    0, 204, 0, 0, 0, 91, 0, 0, 0, 0, 0, 0, 0, 0, 219, 104,
+    0, 0, 0, 221, 0, 0, 0, 137, 91, 137, 0, 222, 0, 137, 137, 137,
+    229, 226, 104, 143, 234, 143, 91, 238, 134, 143, 143, 143, 241, 245, 91, 161,
+    104, 45, 132, 137, 253, 254, 251, 134, 104, 246, 235, 0, 41, 0, 0, 143,
+    261, 91, 91, 91, 91, 91, 91, 91, 91, 91, 91, 91, 91, 91, 91, 91,
+    91, 91, 279, 91, 208, 281, 275, 232, 262, 263, 264, 285, 276, 287, 288, 289,
+    277, 291, 278, 163, 265, 266, 280, 223, 33, 269, 270, 271, 272, 219, 137, 0,
+    229, 91, 137, 303, 229, 237, 260, 267, 268, 305, 143, 104, 0, 248, 143, 0,
+    44, 273, 274, 0, 0, 245, 245, 55, 56, 310, 91, 0, 245, 33, 254, 0,
+    0, 246, 246, 251, 104, 0, 75, 0, 246, 292, 293, 294, 295, 296, 297, 298,
+    0, 224, 0, 0, 0, 0, 0, 230, 0, 0, 0, 0, 318, 0, 232, 0,
+    0, 0, 324, 0, 0, 163, 0, 0, 0, 0, 0, 163, 0, 0, 0, 0,
+    301, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 91, 332, 0, 335,
+    336, 337, 338, 339, 0, 0, 330, 341, 0, 312, 0, 342, 0, 345, 347, 0,
+    0, 0, 0, 0, 0, 0, 0, 351, 352, 0, 354, 0, 357, 0, 359, 0,
+    0, 360, 0, 361, 362, 0, 0, 0, 0, 0, 0, 364, 0, 0, 0, 0,
+    329, 0, 0, 75, 0, 75, 0, 0, 0, 0, 0, 0, 232, 224, 230, 0,
+    0, 0, 0, 0, 163, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 44, 55, 0,
+    0, 75, 0, 0, 75, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0,
+};
+
@@ -0,0 +1,1555 @@
+#include <assert.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "preprocessor.h"
+
+/*
+ * macro is a #define. parameters holds the interned names of the parameters
+ * of a function-like macro, with __VA_ARGS__ last if it is variadic. body is
+ * the replacement list, with parameters marked by TOKEN_PARAMETER. disabled
+ * is non-zero while the macro is being expanded so that it isn't expanded
+ * again.
+ */
+struct macro
+{
+    const char *name;
+    int function_like;
+    int variadic;
+    const char **parameters;
+    int parameters_size;
+    struct token *body;
+    size_t body_size;
+    int disabled;
+    struct macro *next;
+};
+
+/*
+ * header is a file that has been included. Its tokens are scanned once into
+ * the arena and kept, along with the mapped source they were scanned from,
+ * until release_headers() is called at the end of the translation unit. guard is the macro whose definition means including the
+ * header again would have no effect, or NULL if there is none.
+ */
+struct header
+{
+    const char *path;
+    const char *directory;
+    struct source source;
+    struct token *tokens;
+    size_t size;
+    const char *guard;
+    struct header *next;
+};
+
+#define HEADER_CACHE_SIZE 256
+
+/*
+ * Macros and headers are looked up by interned name, so the address of the
+ * name is enough to hash.
+ */
+#define POINTER_HASH(p, size) (((size_t)(p) >> 4) & ((size) - 1))
+
+static struct header *header_cache[HEADER_CACHE_SIZE];
+
+static const char *include_directories[INCLUDE_DIRECTORIES_MAX];
+static int include_directories_size = 0;
+
+/*
+ * Interned names of the directives and operators that are identifiers. #if
+ * and #else are scanned as keywords.
+ */
+static const char *name_define;
+static const char *name_undef;
+static const char *name_include;
+static const char *name_ifdef;
+static const char *name_ifndef;
+static const char *name_elif;
+static const char *name_endif;
+static const char *name_error;
+static const char *name_defined;
+static const char *name_va_args;
+
+static void
+init_names(void)
+{
+    if (name_define != NULL)
+    {
+        return;
+    }
+
+    name_define = intern("define", 6);
+    name_undef = intern("undef", 5);
+    name_include = intern("include", 7);
+    name_ifdef = intern("ifdef", 5);
+    name_ifndef = intern("ifndef", 6);
+    name_elif = intern("elif", 4);
+    name_endif = intern("endif", 5);
+    name_error = intern("error", 5);
+    name_defined = intern("defined", 7);
+    name_va_args = intern("__VA_ARGS__", 11);
+}
+
+/*
+ * Report an error to stderr. Preprocessing stops at the first error, so
+ * preprocessor_next() returns TOK_EOF from then on.
+ */
+static void
+preprocessor_error(struct preprocessor *preprocessor, const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fputc('\n', stderr);
+
+    preprocessor->errors++;
+}
+
+static int
+is_name(const struct token *tok, const char *name)
+{
+    return tok->type == TOK_IDENTIFIER && tok->value == name;
+}
+
+static void
+append_token(struct token_buffer *buffer, const struct token *tok)
+{
+    *token_buffer_push(buffer, tok->type, tok->offset) = *tok;
+}
+
+/*
+ * Returns the interned directory part of path, including the trailing slash.
+ */
+static const char *
+directory_of(const char *path)
+{
+    const char *slash = strrchr(path, '/');
+
+    return intern(path, slash != NULL ? slash - path + 1 : 0);
+}
+
+void
+release_headers(void)
+{
+    struct header *header;
+    int i;
+
+    for (i=0; i<HEADER_CACHE_SIZE; i++)
+    {
+        for (header=header_cache[i]; header!=NULL; header=header->next)
+        {
+            close_source(&header->source);
+        }
+        header_cache[i] = NULL;
+    }
+}
+
+void
+add_include_directory(const char *directory)
+{
+    assert(include_directories_size < INCLUDE_DIRECTORIES_MAX);
+    include_directories[include_directories_size++] = directory;
+}
+
+/*
+ * A directive is a # at the start of a line followed by a name on the same
+ * line.
+ */
+static int
+is_directive(const struct token *tokens)
+{
+    return tokens[0].type == TOK_HASH && (tokens[0].flags & TOKEN_BOL) &&
+           tokens[1].type != TOK_EOF && !(tokens[1].flags & TOKEN_BOL);
+}
+
+static int
+is_line_end(const struct token *tok)
+{
+    return tok->type == TOK_EOF || (tok->flags & TOKEN_BOL);
+}
+
+/*
+ * Returns the macro that guards a header, which is the case when the whole
+ * header is inside an #ifndef X, #if !defined X or #if !defined(X) group with
+ * no #else or #elif. Including the header again while X is defined can then
+ * be skipped without replaying its tokens.
+ */
+static const char *
+include_guard(struct header *header)
+{
+    const struct token *tokens = header->tokens;
+    const char *guard;
+    size_t i;
+    int depth;
+
+    if (!is_directive(&tokens[0]))
+    {
+        return NULL;
+    }
+
+    if (is_name(&tokens[1], name_ifndef) && tokens[2].type == TOK_IDENTIFIER)
+    {
+        guard = tokens[2].value;
+        i = 3;
+    }
+    else if (tokens[1].type == TOK_IF && tokens[2].type == TOK_BANG &&
+             is_name(&tokens[3], name_defined))
+    {
+        if (tokens[4].type == TOK_IDENTIFIER)
+        {
+            guard = tokens[4].value;
+            i = 5;
+        }
+        else if (tokens[4].type == TOK_LPAREN &&
+                 tokens[5].type == TOK_IDENTIFIER &&
+                 tokens[6].type == TOK_RPAREN)
+        {
+            guard = tokens[5].value;
+            i = 7;
+        }
+        else
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        return NULL;
+    }
+
+    if (!is_line_end(&tokens[i]))
+    {
+        return NULL;
+    }
+
+    for (depth=1; tokens[i].type != TOK_EOF; i++)
+    {
+        if (!is_directive(&tokens[i]))
+        {
+            continue;
+        }
+
+        if (tokens[i + 1].type == TOK_IF ||
+            is_name(&tokens[i + 1], name_ifdef) ||
+            is_name(&tokens[i + 1], name_ifndef))
+        {
+            depth++;
+        }
+        else if (depth == 1 && (tokens[i + 1].type == TOK_ELSE ||
+                                is_name(&tokens[i + 1], name_elif)))
+        {
+            return NULL;
+        }
+        else if (is_name(&tokens[i + 1], name_endif) && --depth == 0)
+        {
+            /*
+             * Nothing but the rest of the #endif line may follow.
+             */
+            for (i+=2; tokens[i].type != TOK_EOF; i++)
+            {
+                if (tokens[i].flags & TOKEN_BOL)
+                {
+                    return NULL;
+                }
+            }
+            return guard;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Returns the cached header at path, scanning it the first time it is seen.
+ * Returns NULL if there is no such file.
+ */
+static struct header *
+load_header(const char *filename)
+{
+    const char *path = intern(filename, strlen(filename));
+    struct header **bucket = &header_cache[POINTER_HASH(path,
+                                                        HEADER_CACHE_SIZE)];
+    struct header *header;
+    struct token_buffer tokens;
+    struct scanner scanner;
+    struct token *tok;
+
+    for (header=*bucket; header!=NULL; header=header->next)
+    {
+        if (header->path == path)
+        {
+            return header;
+        }
+    }
+
+    header = arena_alloc(sizeof(struct header));
+
+    if (!open_source(path, &header->source))
+    {
+        return NULL;
+    }
+
+    header->path = path;
+    header->directory = directory_of(path);
+
+    token_buffer_init(&tokens);
+    scanner_init(&scanner, header->source.content, header->source.length);
+    do
+    {
+        tok = next_token(&scanner);
+        append_token(&tokens, tok);
+    } while (tok->type != TOK_EOF);
+
+    header->tokens = tokens.tokens;
+    header->size = tokens.size;
+
+    header->guard = include_guard(header);
+
+    header->next = *bucket;
+    *bucket = header;
+    return header;
+}
+
+/*
+ * Find an included header. Headers included with quotes are looked for in the
+ * directory of the including file first, then in the include directories.
+ */
+static struct header *
+find_header(const char *name, const char *directory)
+{
+    struct header *header;
+    char path[4096];
+    int i;
+
+    if (name[0] == '/')
+    {
+        return load_header(name);
+    }
+
+    if (directory != NULL)
+    {
+        snprintf(path, sizeof(path), "%s%s", directory, name);
+        header = load_header(path);
+        if (header != NULL)
+        {
+            return header;
+        }
+    }
+
+    for (i=0; i<include_directories_size; i++)
+    {
+        snprintf(path, sizeof(path), "%s/%s", include_directories[i], name);
+        header = load_header(path);
+        if (header != NULL)
+        {
+            return header;
+        }
+    }
+
+    return NULL;
+}
+
+static struct macro *
+find_macro(struct preprocessor *preprocessor, const char *name)
+{
+    struct macro *macro;
+
+    macro = preprocessor->macros[POINTER_HASH(name, MACRO_TABLE_SIZE)];
+    for (; macro!=NULL; macro=macro->next)
+    {
+        if (macro->name == name)
+        {
+            return macro;
+        }
+    }
+    return NULL;
+}
+
+static void
+remove_macro(struct preprocessor *preprocessor, const char *name)
+{
+    struct macro **macro;
+
+    macro = &preprocessor->macros[POINTER_HASH(name, MACRO_TABLE_SIZE)];
+    for (; *macro!=NULL; macro=&(*macro)->next)
+    {
+        if ((*macro)->name == name)
+        {
+            *macro = (*macro)->next;
+            return;
+        }
+    }
+}
+
+/*
+ * Returns the next token of the file being preprocessed without consuming it.
+ * At the end of an included header it looks on into the file that included
+ * it, as raw_next() would read, so that the arguments of a function-like
+ * macro named at the end of a header can follow in the includer.
+ */
+static struct token *
+raw_peek(struct preprocessor *preprocessor)
+{
+    struct include_frame *frame;
+    struct token *tok;
+    int i;
+
+    for (i=preprocessor->frames_size-1; ; i--)
+    {
+        frame = &preprocessor->frames[i];
+        if (frame->header == NULL)
+        {
+            return peek_token(&preprocessor->scanner);
+        }
+
+        tok = &frame->header->tokens[frame->position];
+        if (tok->type != TOK_EOF || i == 0)
+        {
+            return tok;
+        }
+    }
+}
+
+/*
+ * Returns and consumes the next token of the file being preprocessed. At the
+ * end of an included header, reading carries on in the file that included it.
+ */
+static struct token *
+raw_next(struct preprocessor *preprocessor)
+{
+    struct include_frame *frame;
+    struct token *tok;
+
+    for (;;)
+    {
+        frame = &preprocessor->frames[preprocessor->frames_size - 1];
+        if (frame->header == NULL)
+        {
+            return next_token(&preprocessor->scanner);
+        }
+
+        tok = &frame->header->tokens[frame->position];
+        if (tok->type != TOK_EOF)
+        {
+            frame->position++;
+            return tok;
+        }
+
+        if (preprocessor->conditionals_size > frame->conditionals_size)
+        {
+            preprocessor_error(preprocessor, "Unterminated conditional in %s",
+                               frame->header->path);
+            preprocessor->conditionals_size = frame->conditionals_size;
+        }
+        preprocessor->frames_size--;
+    }
+}
+
+/*
+ * Consume the rest of a directive line, storing its tokens in line if it is
+ * not NULL.
+ */
+static void
+read_line(struct preprocessor *preprocessor, struct token_buffer *line)
+{
+    struct token *tok;
+
+    if (line != NULL)
+    {
+        token_buffer_init(line);
+    }
+
+    while (!is_line_end(raw_peek(preprocessor)))
+    {
+        tok = raw_next(preprocessor);
+        if (line != NULL)
+        {
+            append_token(line, tok);
+        }
+    }
+}
+
+/*
+ * argument is an argument of a function-like macro invocation, after it has
+ * been macro expanded.
+ */
+struct argument
+{
+    const struct token *tokens;
+    size_t size;
+};
+
+/*
+ * expansion is a macro being expanded. Its tokens are read in place from the
+ * macro body, and a parameter in the body switches to reading the tokens of
+ * the corresponding argument. The macro is disabled while its expansion is on
+ * the stack, which stands in for the hide-set of every token it produces.
+ *
+ * A barrier expansion has no macro and replays a slice of tokens that is being
+ * expanded on its own, such as a macro argument or an #if line. Reading never
+ * goes below a barrier.
+ */
+struct expansion
+{
+    struct macro *macro;
+    const struct token *tokens;
+    size_t size;
+    size_t position;
+    struct argument *arguments;
+    struct argument *argument;
+    size_t argument_position;
+    int barrier;
+};
+
+#define EXPANSION_STACK_INITIAL_CAPACITY 16
+
+static void
+push_expansion(struct preprocessor *preprocessor, struct macro *macro,
+               const struct token *tokens, size_t size,
+               struct argument *arguments)
+{
+    struct expansion *expansion;
+    int capacity;
+
+    if (preprocessor->expansions_size == preprocessor->expansions_capacity)
+    {
+        capacity = preprocessor->expansions_capacity ?
+                   preprocessor->expansions_capacity * 2 :
+                   EXPANSION_STACK_INITIAL_CAPACITY;
+        preprocessor->expansions = arena_realloc(
+            preprocessor->expansions,
+            sizeof(struct expansion) * preprocessor->expansions_capacity,
+            sizeof(struct expansion) * capacity);
+        preprocessor->expansions_capacity = capacity;
+    }
+
+    expansion = &preprocessor->expansions[preprocessor->expansions_size++];
+    expansion->macro = macro;
+    expansion->tokens = tokens;
+    expansion->size = size;
+    expansion->position = 0;
+    expansion->arguments = arguments;
+    expansion->argument = NULL;
+    expansion->argument_position = 0;
+    expansion->barrier = macro == NULL;
+
+    if (macro != NULL)
+    {
+        macro->disabled++;
+    }
+}
+
+static void
+pop_expansion(struct preprocessor *preprocessor)
+{
+    struct expansion *expansion;
+
+    expansion = &preprocessor->expansions[--preprocessor->expansions_size];
+    if (expansion->macro != NULL)
+    {
+        expansion->macro->disabled--;
+    }
+}
+
+/*
+ * Returns and consumes the next token before it is macro expanded, from the
+ * innermost expansion or else from the file. *from_file is set when it came
+ * from the file, in which case it may start a directive. Returns NULL at the
+ * end of a barrier.
+ */
+static const struct token *
+next_unexpanded(struct preprocessor *preprocessor, int *from_file)
+{
+    struct expansion *expansion;
+    const struct token *tok;
+
+    while (preprocessor->expansions_size > 0)
+    {
+        expansion =
+            &preprocessor->expansions[preprocessor->expansions_size - 1];
+
+        if (expansion->argument != NULL)
+        {
+            if (expansion->argument_position < expansion->argument->size)
+            {
+                return &expansion->argument->tokens[
+                    expansion->argument_position++];
+            }
+            expansion->argument = NULL;
+        }
+
+        if (expansion->position < expansion->size)
+        {
+            tok = &expansion->tokens[expansion->position++];
+            if (tok->flags & TOKEN_PARAMETER)
+            {
+                expansion->argument = &expansion->arguments[tok->int_value];
+                expansion->argument_position = 0;
+                continue;
+            }
+            return tok;
+        }
+
+        if (expansion->barrier)
+        {
+            return NULL;
+        }
+        pop_expansion(preprocessor);
+    }
+
+    if (from_file != NULL)
+    {
+        *from_file = 1;
+    }
+
+    /*
+     * The scanner's token is overwritten by peeking, so keep a copy.
+     */
+    preprocessor->token = *raw_next(preprocessor);
+    return &preprocessor->token;
+}
+
+/*
+ * Returns the token next_unexpanded() would return without consuming it.
+ */
+static const struct token *
+peek_unexpanded(struct preprocessor *preprocessor)
+{
+    struct expansion *expansion;
+    struct argument *argument;
+    const struct token *tok;
+    size_t position;
+    int i;
+
+    for (i=preprocessor->expansions_size-1; i>=0; i--)
+    {
+        expansion = &preprocessor->expansions[i];
+
+        if (expansion->argument != NULL &&
+            expansion->argument_position < expansion->argument->size)
+        {
+            return &expansion->argument->tokens[expansion->argument_position];
+        }
+
+        for (position=expansion->position; position<expansion->size;
+             position++)
+        {
+            tok = &expansion->tokens[position];
+            if (!(tok->flags & TOKEN_PARAMETER))
+            {
+                return tok;
+            }
+
+            argument = &expansion->arguments[tok->int_value];
+            if (argument->size > 0)
+            {
+                return &argument->tokens[0];
+            }
+        }
+
+        if (expansion->barrier)
+        {
+            return NULL;
+        }
+    }
+
+    return raw_peek(preprocessor);
+}
+
+static const struct token *expand(struct preprocessor *preprocessor,
+                                  const struct token *tok);
+
+/*
+ * Append the macro expansion of a slice of tokens to out, on its own.
+ */
+static void
+expand_slice(struct preprocessor *preprocessor, const struct token *tokens,
+             size_t size, struct token_buffer *out)
+{
+    const struct token *tok;
+
+    push_expansion(preprocessor, NULL, tokens, size, NULL);
+
+    while ((tok = next_unexpanded(preprocessor, NULL)) != NULL)
+    {
+        tok = expand(preprocessor, tok);
+        if (tok != NULL)
+        {
+            append_token(out, tok);
+        }
+    }
+
+    pop_expansion(preprocessor);
+}
+
+/*
+ * Read the arguments of an invocation of a function-like macro, whose ( has
+ * been consumed, and expand them. Arguments without macros are used as they
+ * are. Returns NULL if the invocation is not terminated or has the wrong
+ * number of arguments.
+ */
+static struct argument *
+collect_arguments(struct preprocessor *preprocessor, struct macro *macro)
+{
+    struct argument *arguments;
+    struct token_buffer buffer, expanded;
+    const struct token *tok;
+    size_t *ends, start, i;
+    int count = 0;
+    int depth = 0;
+    int empty = 1;
+    int p;
+
+    token_buffer_init(&buffer);
+    ends = arena_alloc(sizeof(size_t) * (macro->parameters_size + 1));
+
+    for (;;)
+    {
+        tok = next_unexpanded(preprocessor, NULL);
+        if (tok == NULL || tok->type == TOK_EOF)
+        {
+            preprocessor_error(preprocessor,
+                               "Unterminated invocation of macro %s",
+                               macro->name);
+            return NULL;
+        }
+
+        if (tok->type == TOK_RPAREN && depth == 0)
+        {
+            break;
+        }
+
+        empty = 0;
+
+        /*
+         * Commas inside parentheses and the variable arguments belong to the
+         * argument.
+         */
+        if (tok->type == TOK_COMMA && depth == 0 &&
+            !(macro->variadic && count == macro->parameters_size - 1))
+        {
+            if (count < macro->parameters_size)
+            {
+                ends[count] = buffer.size;
+            }
+            count++;
+            continue;
+        }
+
+        if (tok->type == TOK_LPAREN)
+        {
+            depth++;
+        }
+        else if (tok->type == TOK_RPAREN)
+        {
+            depth--;
+        }
+
+        if (count < macro->parameters_size)
+        {
+            append_token(&buffer, tok);
+        }
+    }
+
+    /*
+     * f() passes no arguments to a macro without parameters, and the
+     * variable arguments may be left out altogether.
+     */
+    count += empty && macro->parameters_size == 0 ? 0 : 1;
+    if (count != macro->parameters_size &&
+        !(macro->variadic && count == macro->parameters_size - 1))
+    {
+        preprocessor_error(preprocessor, "Macro %s expects %d arguments",
+                           macro->name, macro->parameters_size);
+        return NULL;
+    }
+
+    for (p=count>0 ? count-1 : 0; p<macro->parameters_size; p++)
+    {
+        ends[p] = buffer.size;
+    }
+
+    arguments = arena_alloc(sizeof(struct argument) *
+                            (macro->parameters_size + 1));
+
+    for (p=0, start=0; p<macro->parameters_size; start=ends[p++])
+    {
+        arguments[p].tokens = &buffer.tokens[start];
+        arguments[p].size = ends[p] - start;
+
+        for (i=0; i<arguments[p].size; i++)
+        {
+            tok = &arguments[p].tokens[i];
+            if (tok->type == TOK_IDENTIFIER &&
+                find_macro(preprocessor, tok->value) != NULL)
+            {
+                break;
+            }
+        }
+
+        if (i < arguments[p].size)
+        {
+            token_buffer_init(&expanded);
+            expand_slice(preprocessor, arguments[p].tokens, arguments[p].size,
+                         &expanded);
+            arguments[p].tokens = expanded.tokens;
+            arguments[p].size = expanded.size;
+        }
+    }
+
+    return arguments;
+}
+
+/*
+ * If tok invokes a macro, push its expansion and return NULL. Otherwise
+ * return tok, marked so that it is never expanded if it names a macro whose
+ * expansion it is part of.
+ */
+static const struct token *
+expand(struct preprocessor *preprocessor, const struct token *tok)
+{
+    struct argument *arguments = NULL;
+    const struct token *next;
+    struct macro *macro;
+
+    if (tok->type != TOK_IDENTIFIER || (tok->flags & TOKEN_NO_EXPAND))
+    {
+        return tok;
+    }
+
+    macro = find_macro(preprocessor, tok->value);
+    if (macro == NULL)
+    {
+        return tok;
+    }
+
+    if (macro->disabled)
+    {
+        preprocessor->token = *tok;
+        preprocessor->token.flags |= TOKEN_NO_EXPAND;
+        return &preprocessor->token;
+    }
+
+    if (macro->function_like)
+    {
+        /*
+         * A function-like macro name without arguments is left alone. The
+         * arguments may follow the end of the expansion the name came from.
+         */
+        next = peek_unexpanded(preprocessor);
+        if (next == NULL || next->type != TOK_LPAREN)
+        {
+            return tok;
+        }
+
+        next_unexpanded(preprocessor, NULL);
+        arguments = collect_arguments(preprocessor, macro);
+        if (arguments == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    push_expansion(preprocessor, macro, macro->body, macro->body_size,
+                   arguments);
+    return NULL;
+}
+
+static int
+parameter_index(struct macro *macro, const struct token *tok)
+{
+    int i;
+
+    if (tok->type != TOK_IDENTIFIER)
+    {
+        return -1;
+    }
+
+    for (i=0; i<macro->parameters_size; i++)
+    {
+        if (macro->parameters[i] == tok->value)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void
+define_macro(struct preprocessor *preprocessor)
+{
+    struct token_buffer line;
+    struct macro *macro, **bucket;
+    struct token *tokens;
+    size_t i;
+    int p;
+
+    read_line(preprocessor, &line);
+    tokens = line.tokens;
+
+    if (line.size == 0 || tokens[0].type != TOK_IDENTIFIER)
+    {
+        preprocessor_error(preprocessor, "Macro name must be an identifier");
+        return;
+    }
+
+    macro = arena_alloc(sizeof(struct macro));
+    macro->name = tokens[0].value;
+
+    /*
+     * A macro is function-like when a ( follows its name without a space.
+     */
+    i = 1;
+    if (i < line.size && tokens[i].type == TOK_LPAREN &&
+        !(tokens[i].flags & TOKEN_SPACE))
+    {
+        macro->function_like = 1;
+        macro->parameters = arena_alloc(sizeof(const char *) * line.size);
+
+        for (i++; i < line.size && tokens[i].type != TOK_RPAREN; i++)
+        {
+            if (tokens[i].type == TOK_IDENTIFIER)
+            {
+                macro->parameters[macro->parameters_size++] = tokens[i].value;
+            }
+            else if (tokens[i].type == TOK_ELLIPSIS)
+            {
+                macro->parameters[macro->parameters_size++] = name_va_args;
+                macro->variadic = 1;
+            }
+            else if (tokens[i].type != TOK_COMMA)
+            {
+                preprocessor_error(preprocessor,
+                                   "Invalid parameter list for macro %s",
+                                   macro->name);
+                return;
+            }
+        }
+
+        if (i == line.size)
+        {
+            preprocessor_error(preprocessor,
+                               "Missing ) in parameter list of macro %s",
+                               macro->name);
+            return;
+        }
+        i++;
+    }
+
+    macro->body = &tokens[i];
+    macro->body_size = line.size - i;
+
+    /*
+     * Mark the parameters in the body with their index.
+     */
+    for (; i<line.size; i++)
+    {
+        p = parameter_index(macro, &tokens[i]);
+        if (macro->function_like && p >= 0)
+        {
+            tokens[i].flags |= TOKEN_PARAMETER;
+            tokens[i].int_value = p;
+        }
+    }
+
+    remove_macro(preprocessor, macro->name);
+    bucket = &preprocessor->macros[POINTER_HASH(macro->name,
+                                                MACRO_TABLE_SIZE)];
+    macro->next = *bucket;
+    *bucket = macro;
+}
+
+static void
+undefine_macro(struct preprocessor *preprocessor)
+{
+    struct token_buffer line;
+
+    read_line(preprocessor, &line);
+    if (line.size == 0 || line.tokens[0].type != TOK_IDENTIFIER)
+    {
+        preprocessor_error(preprocessor, "Macro name must be an identifier");
+        return;
+    }
+
+    remove_macro(preprocessor, line.tokens[0].value);
+}
+
+static void
+include_header(struct preprocessor *preprocessor)
+{
+    struct include_frame *frame;
+    struct token_buffer line;
+    struct header *header;
+    const char *directory = NULL;
+    char name[4096];
+    size_t i;
+
+    read_line(preprocessor, &line);
+    frame = &preprocessor->frames[preprocessor->frames_size - 1];
+
+    if (line.size > 0 && line.tokens[0].type == TOK_STRING)
+    {
+        snprintf(name, sizeof(name), "%s", line.tokens[0].value);
+        directory = frame->directory;
+    }
+    else if (line.size > 0 && line.tokens[0].type == TOK_LESSTHAN)
+    {
+        /*
+         * The name between < and > is taken from the source since it doesn't
+         * have to be made of tokens.
+         */
+        for (i=1; i<line.size && line.tokens[i].type != TOK_GREATERTHAN; i++)
+        {
+        }
+        if (i == line.size)
+        {
+            preprocessor_error(preprocessor, "Missing > in #include");
+            return;
+        }
+
+        snprintf(name, sizeof(name), "%.*s",
+                 (int)(line.tokens[i].offset - line.tokens[0].offset - 1),
+                 &frame->content[line.tokens[0].offset + 1]);
+    }
+    else
+    {
+        preprocessor_error(preprocessor,
+                           "#include expects \"FILENAME\" or <FILENAME>");
+        return;
+    }
+
+    /*
+     * There are no system include directories, since clink has no headers of
+     * its own and can't parse those of the system. A header included with
+     * angle brackets that isn't in an include directory is assumed to be a
+     * system header and skipped, so that its declarations have to come from
+     * the program.
+     */
+    header = find_header(name, directory);
+    if (header == NULL && directory == NULL)
+    {
+        fprintf(stderr, "Skipping header <%s>, which is not in an include "
+                "directory\n", name);
+        return;
+    }
+    if (header == NULL)
+    {
+        preprocessor_error(preprocessor, "Can't find header %s", name);
+        return;
+    }
+
+    if (header->guard != NULL && find_macro(preprocessor, header->guard))
+    {
+        return;
+    }
+
+    if (preprocessor->frames_size == INCLUDE_MAX_DEPTH)
+    {
+        preprocessor_error(preprocessor,
+                           "Headers nested too deeply including %s", name);
+        return;
+    }
+
+    frame = &preprocessor->frames[preprocessor->frames_size++];
+    frame->header = header;
+    frame->position = 0;
+    frame->content = header->source.content;
+    frame->directory = header->directory;
+    frame->conditionals_size = preprocessor->conditionals_size;
+}
+
+/*
+ * Report the message of an #error, which is the rest of the line as written.
+ */
+static void
+error_directive(struct preprocessor *preprocessor)
+{
+    struct include_frame *frame;
+    struct token_buffer line;
+    size_t start, end, size;
+
+    frame = &preprocessor->frames[preprocessor->frames_size - 1];
+    size = frame->header != NULL ? frame->header->source.length :
+           preprocessor->scanner.content_len;
+
+    read_line(preprocessor, &line);
+    if (line.size == 0)
+    {
+        preprocessor_error(preprocessor, "#error");
+        return;
+    }
+
+    start = line.tokens[0].offset;
+    for (end=start; end<size && frame->content[end]!='\n'; end++)
+    {
+    }
+
+    preprocessor_error(preprocessor, "#error %.*s", (int)(end - start),
+                       &frame->content[start]);
+}
+
+/*
+ * expression is the state of the evaluation of an #if expression.
+ */
+struct expression
+{
+    struct preprocessor *preprocessor;
+    const struct token *tokens;
+    size_t size;
+    size_t position;
+};
+
+static enum token_t
+expression_type(struct expression *e)
+{
+    return e->position < e->size ? e->tokens[e->position].type : TOK_EOF;
+}
+
+static long long evaluate_conditional(struct expression *e);
+
+static long long
+evaluate_unary(struct expression *e)
+{
+    enum token_t type = expression_type(e);
+    long long value;
+
+    if (type == TOK_EOF)
+    {
+        preprocessor_error(e->preprocessor, "Missing operand in #if");
+        return 0;
+    }
+
+    e->position++;
+    switch (type)
+    {
+        case TOK_INTEGER:
+            e->preprocessor->errors +=
+                report_malformed_token(&e->tokens[e->position - 1]);
+            return e->tokens[e->position - 1].int_value;
+        case TOK_BANG:
+            return !evaluate_unary(e);
+        case TOK_MINUS:
+            return -evaluate_unary(e);
+        case TOK_PLUS:
+            return evaluate_unary(e);
+        case TOK_LPAREN:
+            value = evaluate_conditional(e);
+            if (expression_type(e) == TOK_RPAREN)
+            {
+                e->position++;
+            }
+            else
+            {
+                preprocessor_error(e->preprocessor, "Missing ) in #if");
+            }
+            return value;
+        default:
+            /*
+             * Identifiers that are left after macro expansion are 0.
+             */
+            if (type != TOK_IDENTIFIER && type < TOK_VOID)
+            {
+                preprocessor_error(e->preprocessor, "Unexpected token in #if");
+            }
+            return 0;
+    }
+}
+
+static int
+binary_precedence(enum token_t type)
+{
+    switch (type)
+    {
+        case TOK_VERTICALBAR_VERTICALBAR: return 1;
+        case TOK_AMPERSAND_AMPERSAND:     return 2;
+        case TOK_VERTICALBAR:             return 3;
+        case TOK_CARET:                   return 4;
+        case TOK_AMPERSAND:               return 5;
+        case TOK_EQ:
+        case TOK_NEQ:                     return 6;
+        case TOK_LESSTHAN:
+        case TOK_GREATERTHAN:
+        case TOK_LESSTHANEQUAL:
+        case TOK_GREATERTHANEQUAL:        return 7;
+        case TOK_SHIFTLEFT:
+        case TOK_SHIFTRIGHT:              return 8;
+        case TOK_PLUS:
+        case TOK_MINUS:                   return 9;
+        case TOK_ASTERISK:
+        case TOK_BACKSLASH:
+        case TOK_MOD:                     return 10;
+        default:                          return 0;
+    }
+}
+
+static long long
+apply_binary(enum token_t type, long long left, long long right)
+{
+    switch (type)
+    {
+        case TOK_VERTICALBAR_VERTICALBAR: return left || right;
+        case TOK_AMPERSAND_AMPERSAND:     return left && right;
+        case TOK_VERTICALBAR:             return left | right;
+        case TOK_CARET:                   return left ^ right;
+        case TOK_AMPERSAND:               return left & right;
+        case TOK_EQ:                      return left == right;
+        case TOK_NEQ:                     return left != right;
+        case TOK_LESSTHAN:                return left < right;
+        case TOK_GREATERTHAN:             return left > right;
+        case TOK_LESSTHANEQUAL:           return left <= right;
+        case TOK_GREATERTHANEQUAL:        return left >= right;
+        case TOK_SHIFTLEFT:
+            return right >= 0 && right < 64 ? left << right : 0;
+        case TOK_SHIFTRIGHT:
+            return right >= 0 && right < 64 ? left >> right : 0;
+        case TOK_PLUS:                    return left + right;
+        case TOK_MINUS:                   return left - right;
+        case TOK_ASTERISK:                return left * right;
+        /*
+         * Division by zero is 0 since it may be in an operand of && or || that
+         * doesn't matter.
+         */
+        case TOK_BACKSLASH:               return right ? left / right : 0;
+        case TOK_MOD:                     return right ? left % right : 0;
+        default:                          return 0;
+    }
+}
+
+static long long
+evaluate_binary(struct expression *e, int min_precedence)
+{
+    long long left = evaluate_unary(e);
+    long long right;
+    enum token_t type;
+    int precedence;
+
+    for (;;)
+    {
+        type = expression_type(e);
+        precedence = binary_precedence(type);
+        if (precedence == 0 || precedence < min_precedence)
+        {
+            return left;
+        }
+
+        e->position++;
+        right = evaluate_binary(e, precedence + 1);
+        left = apply_binary(type, left, right);
+    }
+}
+
+static long long
+evaluate_conditional(struct expression *e)
+{
+    long long condition = evaluate_binary(e, 1);
+    long long a, b;
+
+    if (expression_type(e) != TOK_QUESTIONMARK)
+    {
+        return condition;
+    }
+
+    e->position++;
+    a = evaluate_conditional(e);
+    if (expression_type(e) == TOK_COLON)
+    {
+        e->position++;
+    }
+    else
+    {
+        preprocessor_error(e->preprocessor, "Missing : in #if");
+    }
+    b = evaluate_conditional(e);
+
+    return condition ? a : b;
+}
+
+/*
+ * Evaluate the expression of an #if or #elif. defined is resolved before the
+ * rest of the line is macro expanded.
+ */
+static int
+evaluate(struct preprocessor *preprocessor, struct token_buffer *line)
+{
+    struct token_buffer resolved, expanded;
+    const struct token *name;
+    struct expression e;
+    struct token *tok;
+    size_t i, offset;
+    int result;
+
+    token_buffer_init(&resolved);
+    for (i=0; i<line->size; i++)
+    {
+        if (!is_name(&line->tokens[i], name_defined))
+        {
+            append_token(&resolved, &line->tokens[i]);
+            continue;
+        }
+
+        offset = line->tokens[i].offset;
+        name = NULL;
+        if (i + 1 < line->size && line->tokens[i + 1].type == TOK_IDENTIFIER)
+        {
+            name = &line->tokens[i + 1];
+            i += 1;
+        }
+        else if (i + 3 < line->size &&
+                 line->tokens[i + 1].type == TOK_LPAREN &&
+                 line->tokens[i + 2].type == TOK_IDENTIFIER &&
+                 line->tokens[i + 3].type == TOK_RPAREN)
+        {
+            name = &line->tokens[i + 2];
+            i += 3;
+        }
+        else
+        {
+            preprocessor_error(preprocessor, "defined expects a macro name");
+        }
+
+        tok = token_buffer_push(&resolved, TOK_INTEGER, offset);
+        tok->int_value = name != NULL &&
+                         find_macro(preprocessor, name->value) != NULL;
+    }
+
+    token_buffer_init(&expanded);
+    expand_slice(preprocessor, resolved.tokens, resolved.size, &expanded);
+
+    e.preprocessor = preprocessor;
+    e.tokens = expanded.tokens;
+    e.size = expanded.size;
+    e.position = 0;
+    result = evaluate_conditional(&e) != 0;
+    if (e.position < e.size)
+    {
+        preprocessor_error(preprocessor,
+                           "Unexpected tokens after #if expression");
+    }
+
+    return result;
+}
+
+static int
+is_active(struct preprocessor *preprocessor)
+{
+    return preprocessor->conditionals_size == 0 ||
+           preprocessor->conditionals[preprocessor->conditionals_size - 1].active;
+}
+
+static void
+push_conditional(struct preprocessor *preprocessor, int condition)
+{
+    struct conditional *conditional;
+    int parent_active = is_active(preprocessor);
+
+    assert(preprocessor->conditionals_size < CONDITIONAL_MAX_DEPTH);
+    conditional =
+        &preprocessor->conditionals[preprocessor->conditionals_size++];
+    conditional->parent_active = parent_active;
+    conditional->active = parent_active && condition;
+    conditional->taken = conditional->active;
+    conditional->seen_else = 0;
+}
+
+/*
+ * Carry out the directive following a # at the start of a line. Only the
+ * conditional directives are looked at inside a group that is skipped.
+ */
+static void
+directive(struct preprocessor *preprocessor)
+{
+    struct conditional *conditional = NULL;
+    struct token_buffer line;
+    struct token name;
+    int active = is_active(preprocessor);
+
+    if (is_line_end(raw_peek(preprocessor)))
+    {
+        return;
+    }
+    name = *raw_next(preprocessor);
+
+    if (preprocessor->conditionals_size > 0)
+    {
+        conditional =
+            &preprocessor->conditionals[preprocessor->conditionals_size - 1];
+    }
+
+    if (name.type == TOK_IF)
+    {
+        read_line(preprocessor, &line);
+        push_conditional(preprocessor,
+                         active && evaluate(preprocessor, &line));
+    }
+    else if (is_name(&name, name_ifdef) || is_name(&name, name_ifndef))
+    {
+        read_line(preprocessor, &line);
+        if (line.size == 0 || line.tokens[0].type != TOK_IDENTIFIER)
+        {
+            preprocessor_error(preprocessor,
+                               "#ifdef and #ifndef expect a macro name");
+            push_conditional(preprocessor, 0);
+            return;
+        }
+
+        push_conditional(preprocessor,
+                         (find_macro(preprocessor, line.tokens[0].value) !=
+                          NULL) == is_name(&name, name_ifdef));
+    }
+    else if (is_name(&name, name_elif) || name.type == TOK_ELSE ||
+             is_name(&name, name_endif))
+    {
+        if (conditional == NULL)
+        {
+            preprocessor_error(preprocessor,
+                               "#else, #elif or #endif without #if");
+            read_line(preprocessor, NULL);
+            return;
+        }
+
+        if (name.type != TOK_ELSE && !is_name(&name, name_elif))
+        {
+            read_line(preprocessor, NULL);
+            preprocessor->conditionals_size--;
+            return;
+        }
+
+        if (conditional->seen_else)
+        {
+            preprocessor_error(preprocessor, "#else or #elif after #else");
+        }
+
+        if (name.type == TOK_ELSE)
+        {
+            read_line(preprocessor, NULL);
+            conditional->active = conditional->parent_active &&
+                                  !conditional->taken;
+            conditional->seen_else = 1;
+        }
+        else if (conditional->parent_active && !conditional->taken)
+        {
+            read_line(preprocessor, &line);
+            conditional->active = evaluate(preprocessor, &line);
+        }
+        else
+        {
+            read_line(preprocessor, NULL);
+            conditional->active = 0;
+        }
+        conditional->taken |= conditional->active;
+    }
+    else if (!active)
+    {
+        read_line(preprocessor, NULL);
+    }
+    else if (is_name(&name, name_define))
+    {
+        define_macro(preprocessor);
+    }
+    else if (is_name(&name, name_undef))
+    {
+        undefine_macro(preprocessor);
+    }
+    else if (is_name(&name, name_include))
+    {
+        include_header(preprocessor);
+    }
+    else if (is_name(&name, name_error))
+    {
+        error_directive(preprocessor);
+    }
+    else
+    {
+        /*
+         * Other directives, such as #pragma and #line, are ignored.
+         */
+        read_line(preprocessor, NULL);
+    }
+}
+
+void
+preprocessor_init(struct preprocessor *preprocessor, const char *filename,
+                  char *content, size_t content_len)
+{
+    init_names();
+
+    memset(preprocessor, 0, sizeof(struct preprocessor));
+    scanner_init(&preprocessor->scanner, content, content_len);
+
+    preprocessor->frames[0].content = content;
+    preprocessor->frames[0].directory = filename != NULL ?
+                                        directory_of(filename) : "";
+    preprocessor->frames_size = 1;
+
+}
+
+struct token *
+preprocessor_next(struct preprocessor *preprocessor)
+{
+    const struct token *tok;
+    int from_file;
+
+    for (;;)
+    {
+        if (preprocessor->errors > 0)
+        {
+            memset(&preprocessor->token, 0, sizeof(struct token));
+            preprocessor->token.type = TOK_EOF;
+            return &preprocessor->token;
+        }
+
+        from_file = 0;
+        tok = next_unexpanded(preprocessor, &from_file);
+
+        if (from_file)
+        {
+            if (tok->type == TOK_HASH && (tok->flags & TOKEN_BOL))
+            {
+                directive(preprocessor);
+                continue;
+            }
+
+            if (tok->type == TOK_EOF)
+            {
+                if (preprocessor->conditionals_size > 0)
+                {
+                    preprocessor_error(preprocessor,
+                                       "Unterminated conditional");
+                    preprocessor->conditionals_size = 0;
+                }
+                return &preprocessor->token;
+            }
+
+            if (!is_active(preprocessor))
+            {
+                continue;
+            }
+        }
+
+        /*
+         * Tokens are only copied out of the macro they come from once they
+         * are returned.
+         */
+        tok = expand(preprocessor, tok);
+        if (tok == NULL)
+        {
+            continue;
+        }
+
+        /*
+         * Malformed tokens are only errors once they are reached, and not in
+         * a group that is skipped. They stop preprocessing as well.
+         */
+        if (tok->flags & TOKEN_MALFORMED)
+        {
+            preprocessor->errors += report_malformed_token(tok);
+            continue;
+        }
+
+        preprocessor->token = *tok;
+        return &preprocessor->token;
+    }
+}
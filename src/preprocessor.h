@@ -0,0 +1,98 @@
+#ifndef __PREPROCESSOR_H__
+#define __PREPROCESSOR_H__
+
+#include "scanner.h"
+
+#define MACRO_TABLE_SIZE 256
+#define INCLUDE_MAX_DEPTH 64
+#define CONDITIONAL_MAX_DEPTH 64
+#define INCLUDE_DIRECTORIES_MAX 64
+
+struct header;
+struct macro;
+struct expansion;
+
+/*
+ * include_frame is a file being preprocessed. The main file is scanned as it
+ * is read, and included headers are replayed from the tokens cached when the
+ * header was first included. conditionals_size is the depth of the
+ * conditional stack when the file was entered.
+ */
+struct include_frame
+{
+    struct header *header;
+    size_t position;
+    const char *content;
+    const char *directory;
+    int conditionals_size;
+};
+
+/*
+ * conditional is an #if, #ifdef or #ifndef group being preprocessed. taken is
+ * set once one of its branches has been included.
+ */
+struct conditional
+{
+    int parent_active;
+    int active;
+    int taken;
+    int seen_else;
+};
+
+/*
+ * preprocessor turns the tokens of a main file into the tokens the parser
+ * sees by carrying out directives and expanding macros. expansions is the
+ * stack of macros being expanded, innermost last. errors is the number of
+ * errors reported, including malformed tokens that are reached.
+ */
+struct preprocessor
+{
+    struct scanner scanner;
+
+    struct include_frame frames[INCLUDE_MAX_DEPTH];
+    int frames_size;
+
+    struct conditional conditionals[CONDITIONAL_MAX_DEPTH];
+    int conditionals_size;
+
+    struct macro *macros[MACRO_TABLE_SIZE];
+
+    struct expansion *expansions;
+    int expansions_size;
+    int expansions_capacity;
+
+    struct token token;
+
+    int errors;
+};
+
+/*
+ * Add a directory to search for included headers. The directories apply to
+ * every file preprocessed by the process. There are no system include
+ * directories: a header included with angle brackets that is not found in
+ * these is skipped.
+ */
+void add_include_directory(const char *directory);
+
+/*
+ * Close the headers included since the last call and forget them, so that
+ * they are read again by the next translation unit. Their tokens are in the
+ * arena, so this must be called before arena_release().
+ */
+void release_headers(void);
+
+/*
+ * Start preprocessing content. filename is used to find headers included with
+ * quotes and may be NULL.
+ */
+void preprocessor_init(struct preprocessor *preprocessor, const char *filename,
+                       char *content, size_t content_len);
+
+/*
+ * Returns the next preprocessed token. After the end of the main file, or once
+ * an error has been reported to stderr, every call returns TOK_EOF. The token
+ * is only valid until the next call.
+ */
+struct token *preprocessor_next(struct preprocessor *preprocessor);
+
+#endif
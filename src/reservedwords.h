@@ -0,0 +1,85 @@
+/* Generated by genrw. Do not edit. */
+
+#define RESERVED_WORDS_SIZE 64
+#define MIN_RESERVED_WORD_LENGTH 2
+#define MAX_RESERVED_WORD_LENGTH 8
+
+static const unsigned char reserved_word_values[128] =
+{
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0, 61,  5, 23, 38, 52, 14, 14, 47, 59,  0, 32, 45, 18,  1,  7,
+     0,  0, 34, 38, 41, 20, 11, 61,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+static const struct reserved_word reserved_words[RESERVED_WORDS_SIZE] =
+{
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "unsigned", 8, TOK_UNSIGNED },
+    { "static", 6, TOK_STATIC },
+    { "", 0, TOK_EOF },
+    { "const", 5, TOK_CONST },
+    { "", 0, TOK_EOF },
+    { "volatile", 8, TOK_VOLATILE },
+    { "auto", 4, TOK_AUTO },
+    { "", 0, TOK_EOF },
+    { "enum", 4, TOK_ENUM },
+    { "if", 2, TOK_IF },
+    { "register", 8, TOK_REGISTER },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "case", 4, TOK_CASE },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "signed", 6, TOK_SIGNED },
+    { "continue", 8, TOK_CONTINUE },
+    { "short", 5, TOK_SHORT },
+    { "struct", 6, TOK_STRUCT },
+    { "default", 7, TOK_DEFAULT },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "goto", 4, TOK_GOTO },
+    { "union", 5, TOK_UNION },
+    { "switch", 6, TOK_SWITCH },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "double", 6, TOK_DOUBLE },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "int", 3, TOK_INT },
+    { "", 0, TOK_EOF },
+    { "return", 6, TOK_RETURN },
+    { "break", 5, TOK_BREAK },
+    { "", 0, TOK_EOF },
+    { "else", 4, TOK_ELSE },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "do", 2, TOK_DO },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "for", 3, TOK_FOR },
+    { "", 0, TOK_EOF },
+    { "void", 4, TOK_VOID },
+    { "while", 5, TOK_WHILE },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "", 0, TOK_EOF },
+    { "extern", 6, TOK_EXTERN },
+    { "float", 5, TOK_FLOAT },
+    { "char", 4, TOK_CHAR },
+    { "typedef", 7, TOK_TYPEDEF },
+    { "long", 4, TOK_LONG },
+};
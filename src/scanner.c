@@ -1,537 +1,858 @@
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#include "scanner.h"
+/*
+ * The vector scanning kernels use x86 intrinsics along with the target
+ * attribute and CPU detection builtins of GCC and Clang. Everywhere else only
+ * the scalar kernels are built.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define SCAN_X86 1
+#endif
 
-static enum token_t reserved_word_token(char *str, size_t len);
+#include "scanner.h"
 
-struct token reserved_map[] =
+/*
+ * reserved_words is a perfect hash table of the reserved words, keyed by
+ * reserved_word_hash(). It is generated into reservedwords.h by genrw, which
+ * searches for reserved_word_values so that no two reserved words share a
+ * slot. Empty slots have a length of zero.
+ */
+struct reserved_word
 {
-    { TOK_VOID, "void" },
-    { TOK_CHAR, "char" },
-    { TOK_SHORT, "short" },
-    { TOK_INT, "int" },
-    { TOK_LONG, "long" },
-    { TOK_FLOAT, "float" },
-    { TOK_DOUBLE, "double" },
-    { TOK_SIGNED, "signed" },
-    { TOK_UNSIGNED, "unsigned" },
-    { TOK_GOTO, "goto" },
-    { TOK_CONTINUE, "continue" },
-    { TOK_BREAK, "break" },
-    { TOK_RETURN, "return" },
-    { TOK_FOR, "for" },
-    { TOK_DO, "do" },
-    { TOK_WHILE, "while" },
-    { TOK_IF, "if" },
-    { TOK_ELSE, "else" },
-    { TOK_SWITCH, "switch" },
-    { TOK_CASE, "case" },
-    { TOK_DEFAULT, "default" },
-    { TOK_ENUM, "enum" },
-    { TOK_STRUCT, "struct" },
-    { TOK_UNION, "union" },
-    { TOK_CONST, "const" },
-    { TOK_VOLATILE, "volatile" },
-    { TOK_AUTO, "auto" },
-    { TOK_REGISTER, "register" },
-    { TOK_STATIC, "static" },
-    { TOK_EXTERN, "extern" },
-    { TOK_TYPEDEF, "typedef" },
-    { TOK_EOF, "" } /* TOK_EOF must be last entry */
+    const char *name;
+    size_t length;
+    enum token_t type;
 };
 
+#include "reservedwords.h"
+
+static unsigned int
+reserved_word_hash(const char *str, size_t len)
+{
+    return (len + reserved_word_values[str[0] & 0x7f] +
+            reserved_word_values[str[len - 1] & 0x7f]) &
+           (RESERVED_WORDS_SIZE - 1);
+}
+
+/*
+ * Returns the token of a reserved word, or TOK_EOF if str is not one.
+ */
 static enum token_t
 reserved_word_token(char *str, size_t len)
 {
-    enum token_t t = TOK_EOF;
-    int i;
+    const struct reserved_word *word;
 
-    for (i = 0; reserved_map[i].type != TOK_EOF; i++)
+    if (len < MIN_RESERVED_WORD_LENGTH || len > MAX_RESERVED_WORD_LENGTH)
     {
-        if (len != strlen(reserved_map[i].value))
-        {
-            continue;
-        }
-        if (strncmp(str, reserved_map[i].value, len) == 0)
-        {
-            t = reserved_map[i].type;
-            break;
-        }
+        return TOK_EOF;
     }
 
-    return t;
+    word = &reserved_words[reserved_word_hash(str, len)];
+    if (word->length == len && memcmp(str, word->name, len) == 0)
+    {
+        return word->type;
+    }
+
+    return TOK_EOF;
 }
 
 void
-preprocess(char *infile, char *outfile)
+token_buffer_init(struct token_buffer *buffer)
 {
-    char *in_content;
-    char *out_content;
-    int in_index;
-    int out_index;
-    struct listnode *transforms;
-
-    list_init(&transforms);
-
-    /*
-     * Find macros and includes inside infile in order to construct outfile
-     * replacing  macros and includes
-     */
-    for (;;)
-    {
-    }
+    buffer->tokens = NULL;
+    buffer->size = 0;
+    buffer->capacity = 0;
 }
 
-void
-scan(char *content, size_t content_len, struct listnode **tokens)
+/*
+ * Append a token that starts at offset in the source and return it. The
+ * token is only valid until the next token is appended, since the buffer may
+ * be moved when it grows.
+ */
+struct token *
+token_buffer_push(struct token_buffer *buffer, enum token_t type,
+                  size_t offset)
 {
     struct token *tok;
-    size_t i, tok_start, tok_end, tok_size;
+    size_t capacity;
 
-    for (i=0; i<content_len;)
+    if (buffer->size == buffer->capacity)
     {
-        if (isalpha(content[i]) || content[i] == '_')
-        {
-            tok_start = i;
-
-            /* consume characters */
-            while (i < content_len && (isalpha(content[i]) ||
-                                       isdigit(content[i]) ||
-                                       content[i] == '_'))
-            {
-                i += 1;
-            }
-            tok_end = i;
-            tok_size = tok_end - tok_start;
+        capacity = buffer->capacity ? buffer->capacity * 2 :
+                   TOKEN_BUFFER_INITIAL_CAPACITY;
+        buffer->tokens = arena_realloc(buffer->tokens,
+                                       sizeof(struct token) * buffer->capacity,
+                                       sizeof(struct token) * capacity);
+        buffer->capacity = capacity;
+    }
 
-            tok = (struct token *)malloc(sizeof(struct token));
+    tok = &buffer->tokens[buffer->size++];
+    tok->type = type;
+    tok->value = NULL;
+    tok->int_value = 0;
+    tok->flags = 0;
+    tok->offset = offset;
+    return tok;
+}
 
-            /*
-             * Check if this token is a reserved word. If not then consider it
-             * a label.
-             */
-            tok->type = reserved_word_token(&content[tok_start], tok_size);
-            if (tok->type == TOK_EOF)
-            {
-                tok->type = TOK_IDENTIFIER;
-                tok->value = (char *)malloc(sizeof(char) * tok_size + 1);
-                strncpy(tok->value, content + tok_start, tok_size);
-                tok->value[tok_size] = '\0';
-            }
+/*
+ * char_classes holds the class of each character so that runs of whitespace,
+ * identifier characters and digits can be consumed with a table lookup rather
+ * than locale-dependent ctype calls. Characters outside ASCII have no class.
+ */
+#define CHAR_SPACE      0x1
+#define CHAR_DIGIT      0x2
+#define CHAR_ALPHA      0x4
+#define CHAR_IDENTIFIER (CHAR_ALPHA | CHAR_DIGIT)
+
+#define S CHAR_SPACE
+#define D CHAR_DIGIT
+#define A CHAR_ALPHA
+static const unsigned char char_classes[256] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 0, S, S, S, S, S, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    S, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    D, D, D, D, D, D, D, D, D, D, 0, 0, 0, 0, 0, 0,
+    0, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A,
+    A, A, A, A, A, A, A, A, A, A, A, 0, 0, 0, 0, A,
+    0, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A,
+    A, A, A, A, A, A, A, A, A, A, A, 0, 0, 0, 0, 0,
+};
+#undef S
+#undef D
+#undef A
+
+/*
+ * Length in characters of each operator and punctuation token, indexed by
+ * token type + 1 to make room for TOK_EOF. Reserved words and tokens whose
+ * length depends on the input have already been consumed when their length is
+ * looked up, so their length is zero.
+ */
+static const unsigned char token_lengths[NUM_TOKENS] =
+{
+    0, /* TOK_EOF */
+    0, /* TOK_INTEGER */
+    0, /* TOK_STRING */
+    0, /* TOK_IDENTIFIER */
+    1, /* TOK_LPAREN */
+    1, /* TOK_RPAREN */
+    1, /* TOK_LBRACKET */
+    1, /* TOK_RBRACKET */
+    1, /* TOK_LBRACE */
+    1, /* TOK_RBRACE */
+    1, /* TOK_SEMICOLON */
+    1, /* TOK_EQUAL */
+    1, /* TOK_BACKSLASH */
+    2, /* TOK_BACKSLASH_EQUAL */
+    1, /* TOK_MOD */
+    2, /* TOK_MOD_EQUAL */
+    1, /* TOK_BANG */
+    1, /* TOK_PLUS */
+    2, /* TOK_PLUS_PLUS */
+    2, /* TOK_PLUS_EQUAL */
+    1, /* TOK_MINUS */
+    2, /* TOK_MINUS_MINUS */
+    2, /* TOK_MINUS_EQUAL */
+    2, /* TOK_ARROW */
+    1, /* TOK_ASTERISK */
+    2, /* TOK_ASTERISK_EQUAL */
+    1, /* TOK_AMPERSAND */
+    2, /* TOK_AMPERSAND_AMPERSAND */
+    1, /* TOK_CARET */
+    1, /* TOK_COMMA */
+    1, /* TOK_DOT */
+    3, /* TOK_ELLIPSIS */
+    1, /* TOK_QUESTIONMARK */
+    1, /* TOK_COLON */
+    1, /* TOK_VERTICALBAR */
+    2, /* TOK_VERTICALBAR_VERTICALBAR */
+    1, /* TOK_SINGLEQUOTE */
+    2, /* TOK_SHIFTLEFT */
+    2, /* TOK_SHIFTRIGHT */
+    1, /* TOK_LESSTHAN */
+    1, /* TOK_GREATERTHAN */
+    2, /* TOK_LESSTHANEQUAL */
+    2, /* TOK_GREATERTHANEQUAL */
+    2, /* TOK_EQ */
+    2, /* TOK_NEQ */
+    1, /* TOK_HASH */
+};
 
-            list_append(tokens, tok);
-        }
-        else if (isdigit(content[i]))
-        {
-            tok_start = i;
+#define IS_CLASS(c, class) (char_classes[(unsigned char)(c)] & (class))
+
+/*
+ * The scan kernels find the next byte of interest from position i onwards and
+ * return its index, or n if there is none:
+ *
+ *   skip_space     - the first byte that is not whitespace
+ *   comment_end    - the '*' of the first star slash pair
+ *   string_special - the first '"' or '\'
+ *
+ * Each has a scalar version and, where SCAN_X86 is defined, SSE2 and AVX2
+ * versions that test 16 or 32 bytes at a time. The vector versions never load
+ * past n and finish with the scalar version. select_scan_kernels() picks the widest set that
+ * the CPU supports the first time scan() is called.
+ */
+struct scan_kernels
+{
+    size_t (*skip_space)(const char *s, size_t i, size_t n);
+    size_t (*comment_end)(const char *s, size_t i, size_t n);
+    size_t (*string_special)(const char *s, size_t i, size_t n);
+};
 
-            /* consume digits */
-            while (i < content_len && isdigit(content[i]))
-            {
-                i += 1;
-            }
-            tok_end = i;
-            tok_size = tok_end - tok_start;
+static size_t
+skip_space_scalar(const char *s, size_t i, size_t n)
+{
+    while (i < n && IS_CLASS(s[i], CHAR_SPACE))
+    {
+        i += 1;
+    }
+    return i;
+}
 
-            tok = (struct token *)malloc(sizeof(struct token));
+static size_t
+comment_end_scalar(const char *s, size_t i, size_t n)
+{
+    while (i + 1 < n && !(s[i] == '*' && s[i + 1] == '/'))
+    {
+        i += 1;
+    }
+    return i + 1 < n ? i : n;
+}
 
-            tok->type = TOK_INTEGER;
-            tok->value = (char *)malloc(sizeof(char) * tok_size);
-            strncpy(tok->value, content + tok_start, tok_size);
-            tok->value[tok_size] = '\0';
+static size_t
+string_special_scalar(const char *s, size_t i, size_t n)
+{
+    while (i < n && s[i] != '"' && s[i] != '\\')
+    {
+        i += 1;
+    }
+    return i;
+}
 
-            list_append(tokens, tok);
-        }
-        else if (content[i] == '(')
-        {
-            i += 1;
+static const struct scan_kernels scalar_kernels =
+{
+    skip_space_scalar,
+    comment_end_scalar,
+    string_special_scalar,
+};
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_LPAREN;
+#ifdef SCAN_X86
+/*
+ * Whitespace is ' ' or '\t' to '\r'. The range test is done by subtracting
+ * '\t' and checking that the unsigned result is at most 4, which is when
+ * taking the unsigned minimum with 4 leaves it unchanged.
+ */
+__attribute__((target("sse2")))
+static size_t
+skip_space_sse2(const char *s, size_t i, size_t n)
+{
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i four = _mm_set1_epi8(4);
+    __m128i v, r;
+    unsigned mask;
 
-            list_append(tokens, tok);
-        }
-        else if (content[i] == ')')
+    for (; i + 16 <= n; i += 16)
+    {
+        v = _mm_loadu_si128((const __m128i *)&s[i]);
+        r = _mm_sub_epi8(v, tab);
+        r = _mm_cmpeq_epi8(_mm_min_epu8(r, four), r);
+        r = _mm_or_si128(r, _mm_cmpeq_epi8(v, space));
+        mask = ~_mm_movemask_epi8(r) & 0xffff;
+        if (mask)
         {
-            i += 1;
-
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_RPAREN;
-
-            list_append(tokens, tok);
+            return i + __builtin_ctz(mask);
         }
-        else if (content[i] == '[')
-        {
-            i += 1;
+    }
+    return skip_space_scalar(s, i, n);
+}
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_LBRACKET;
+__attribute__((target("sse2")))
+static size_t
+comment_end_sse2(const char *s, size_t i, size_t n)
+{
+    const __m128i star = _mm_set1_epi8('*');
+    const __m128i slash = _mm_set1_epi8('/');
+    __m128i a, b;
+    unsigned mask;
 
-            list_append(tokens, tok);
-        }
-        else if (content[i] == ']')
+    for (; i + 17 <= n; i += 16)
+    {
+        a = _mm_loadu_si128((const __m128i *)&s[i]);
+        b = _mm_loadu_si128((const __m128i *)&s[i + 1]);
+        mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, star),
+                                               _mm_cmpeq_epi8(b, slash)));
+        if (mask)
         {
-            i += 1;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return comment_end_scalar(s, i, n);
+}
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_RBRACKET;
+__attribute__((target("sse2")))
+static size_t
+string_special_sse2(const char *s, size_t i, size_t n)
+{
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    __m128i v;
+    unsigned mask;
 
-            list_append(tokens, tok);
-        }
-        else if (content[i] == '{')
+    for (; i + 16 <= n; i += 16)
+    {
+        v = _mm_loadu_si128((const __m128i *)&s[i]);
+        mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                                              _mm_cmpeq_epi8(v, backslash)));
+        if (mask)
         {
-            i += 1;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return string_special_scalar(s, i, n);
+}
+
+static const struct scan_kernels sse2_kernels =
+{
+    skip_space_sse2,
+    comment_end_sse2,
+    string_special_sse2,
+};
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_LBRACE;
+__attribute__((target("avx2")))
+static size_t
+skip_space_avx2(const char *s, size_t i, size_t n)
+{
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i four = _mm256_set1_epi8(4);
+    __m256i v, r;
+    unsigned mask;
 
-            list_append(tokens, tok);
-        }
-        else if (content[i] == '}')
+    for (; i + 32 <= n; i += 32)
+    {
+        v = _mm256_loadu_si256((const __m256i *)&s[i]);
+        r = _mm256_sub_epi8(v, tab);
+        r = _mm256_cmpeq_epi8(_mm256_min_epu8(r, four), r);
+        r = _mm256_or_si256(r, _mm256_cmpeq_epi8(v, space));
+        mask = ~(unsigned)_mm256_movemask_epi8(r);
+        if (mask)
         {
-            i += 1;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return skip_space_sse2(s, i, n);
+}
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_RBRACE;
+__attribute__((target("avx2")))
+static size_t
+comment_end_avx2(const char *s, size_t i, size_t n)
+{
+    const __m256i star = _mm256_set1_epi8('*');
+    const __m256i slash = _mm256_set1_epi8('/');
+    __m256i a, b;
+    unsigned mask;
 
-            list_append(tokens, tok);
-        }
-        else if (content[i] == ';')
+    for (; i + 33 <= n; i += 32)
+    {
+        a = _mm256_loadu_si256((const __m256i *)&s[i]);
+        b = _mm256_loadu_si256((const __m256i *)&s[i + 1]);
+        mask = _mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(a, star),
+                             _mm256_cmpeq_epi8(b, slash)));
+        if (mask)
         {
-            i += 1;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return comment_end_sse2(s, i, n);
+}
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_SEMICOLON;
+__attribute__((target("avx2")))
+static size_t
+string_special_avx2(const char *s, size_t i, size_t n)
+{
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    __m256i v;
+    unsigned mask;
 
-            list_append(tokens, tok);
-        }
-        else if (content[i] == '=')
+    for (; i + 32 <= n; i += 32)
+    {
+        v = _mm256_loadu_si256((const __m256i *)&s[i]);
+        mask = _mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, quote),
+                            _mm256_cmpeq_epi8(v, backslash)));
+        if (mask)
         {
-            i += 1;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return string_special_sse2(s, i, n);
+}
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_EQUAL;
+static const struct scan_kernels avx2_kernels =
+{
+    skip_space_avx2,
+    comment_end_avx2,
+    string_special_avx2,
+};
+#endif
 
-            if (i < content_len && content[i] == '=')
-            {
-                i += 1;
-                tok->type = TOK_EQ;
-            }
+static const struct scan_kernels *kernels;
 
-            list_append(tokens, tok);
-        }
-        else if (content[i] == '!')
-        {
-            i += 1;
+static void
+select_scan_kernels(void)
+{
+    kernels = &scalar_kernels;
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_BANG;
+#ifdef SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        kernels = &avx2_kernels;
+    }
+    else if (__builtin_cpu_supports("sse2"))
+    {
+        kernels = &sse2_kernels;
+    }
+#endif
+}
 
-            if (i < content_len && content[i] == '=')
-            {
-                i += 1;
-                tok->type = TOK_NEQ;
-            }
+/*
+ * Converts the integer constant starting at content[i] into a value and the
+ * flags of its suffixes, and returns the index after it. Constants starting
+ * with 0x are hexadecimal and other constants starting with 0 are octal.
+ * Constants that don't fit in 64 bits, which saturate, hexadecimal constants
+ * without digits and octal constants with 8 or 9 in them are flagged as
+ * malformed.
+ */
+static size_t
+scan_integer(const char *content, size_t i, size_t content_len,
+             unsigned long long *int_value, int *flags)
+{
+    unsigned long long value = 0;
+    unsigned base = 10;
+    unsigned digit;
+    size_t start = i;
+    int malformed = 0;
+    char c;
+
+    if (content[i] == '0' && i + 1 < content_len &&
+        (content[i + 1] | 0x20) == 'x')
+    {
+        base = 16;
+        i += 2;
+    }
+    else if (content[i] == '0')
+    {
+        base = 8;
+    }
 
-            list_append(tokens, tok);
+    for (; i < content_len; i++)
+    {
+        c = content[i];
+        if (IS_CLASS(c, CHAR_DIGIT))
+        {
+            digit = c - '0';
         }
-        else if (content[i] == '+')
+        else if (base == 16 && (c | 0x20) >= 'a' && (c | 0x20) <= 'f')
         {
-            i += 1;
-
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_PLUS;
-
-            if (i < content_len && content[i] == '+')
-            {
-                i += 1;
-                tok->type = TOK_PLUS_PLUS;
-            }
-            else if (i < content_len && content[i] == '=')
-            {
-                i += 1;
-                tok->type = TOK_PLUS_EQUAL;
-            }
-
-            list_append(tokens, tok);
+            digit = (c | 0x20) - 'a' + 10;
         }
-        else if (content[i] == '-')
+        else
         {
-            i += 1;
-
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_MINUS;
-
-            if (i < content_len && content[i] == '-')
-            {
-                i += 1;
-                tok->type = TOK_MINUS_MINUS;
-            }
-            else if (i < content_len && content[i] == '=')
-            {
-                i += 1;
-                tok->type = TOK_MINUS_EQUAL;
-            }
-            else if (i < content_len && content[i] == '>')
-            {
-                i += 1;
-                tok->type = TOK_ARROW;
-            }
+            break;
+        }
 
-            list_append(tokens, tok);
+        if (digit >= base)
+        {
+            malformed |= TOKEN_BAD_DIGIT;
         }
-        else if (content[i] == '*')
+
+        if (value > (ULLONG_MAX - digit) / base)
         {
-            i += 1;
+            malformed |= TOKEN_TOO_LARGE;
+        }
+        value = value * base + digit;
+    }
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_ASTERISK;
+    if (base == 16 && i == start + 2)
+    {
+        malformed |= TOKEN_NO_DIGITS;
+    }
 
-            if (i < content_len && content[i] == '=')
-            {
-                i += 1;
-                tok->type = TOK_ASTERISK_EQUAL;
-            }
+    if (malformed & TOKEN_TOO_LARGE)
+    {
+        value = ULLONG_MAX;
+    }
 
-            list_append(tokens, tok);
+    /*
+     * Suffixes are u or U and l, L, ll or LL in either order.
+     */
+    *flags = malformed;
+    for (; i < content_len; i++)
+    {
+        c = content[i];
+        if ((c == 'u' || c == 'U') && !(*flags & TOKEN_UNSIGNED))
+        {
+            *flags |= TOKEN_UNSIGNED;
         }
-        else if (content[i] == '&')
+        else if ((c == 'l' || c == 'L') &&
+                 !(*flags & (TOKEN_LONG | TOKEN_LONG_LONG)))
         {
-            i += 1;
-
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_AMPERSAND;
-
-            if (content[i] == '&')
+            *flags |= TOKEN_LONG;
+            if (i + 1 < content_len && content[i + 1] == c)
             {
+                *flags ^= TOKEN_LONG | TOKEN_LONG_LONG;
                 i += 1;
-                tok->type = TOK_AMPERSAND_AMPERSAND;
             }
-
-            list_append(tokens, tok);
         }
-        else if (content[i] == '\'')
+        else
         {
-            i += 1;
-
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_SINGLEQUOTE;
-
-            list_append(tokens, tok);
+            break;
         }
-        else if (content[i] == '"')
-        {
-            /* consume first " */
-            i += 1;
-            tok_start = i;
+    }
 
-            tok = (struct token *)malloc(sizeof(struct token));
+    *int_value = value;
+    return i;
+}
 
-            /* consume characters */
-            while (i < content_len && content[i] != '"')
-            {
-                i += 1;
-            }
-            tok_end = i;
+void
+scanner_init(struct scanner *scanner, char *content, size_t content_len)
+{
+    if (kernels == NULL)
+    {
+        select_scan_kernels();
+    }
 
-            /* consume next " */
-            i += 1;
+    scanner->content = content;
+    scanner->content_len = content_len;
+    scanner->position = 0;
+    scanner->peeked = 0;
+}
 
-            tok_size = tok_end - tok_start;
-            tok->value = malloc(sizeof(char) * tok_size);
-            strncpy(tok->value, &content[tok_start], tok_size);
+/*
+ * Scans the token at the scanner's position into tok and moves the position
+ * past it. tok is TOK_EOF at the end of the content.
+ */
+static void
+scan_token(struct scanner *scanner, struct token *tok)
+{
+    char *content = scanner->content;
+    size_t content_len = scanner->content_len;
+    unsigned long long int_value;
+    const char *value;
+    enum token_t type;
+    size_t i, start;
+    const char *end;
+    int flags, leading;
+    char c, next;
 
-            tok->type = TOK_STRING;
+    /*
+     * leading collects the TOKEN_BOL and TOKEN_SPACE flags of the whitespace
+     * and comments before the token.
+     */
+    leading = scanner->position == 0 ? TOKEN_BOL : 0;
 
-            list_append(tokens, tok);
+    for (i=scanner->position; i<content_len;)
+    {
+        start = i;
+        value = NULL;
+        int_value = 0;
+        flags = 0;
+        next = i + 1 < content_len ? content[i + 1] : '\0';
+
+        /*
+         * Dispatch on the first character of the token, with every letter
+         * and _ dispatched as 'a' and every digit as '0'. Every case leaves i
+         * after the last character it consumed.
+         */
+        c = content[i];
+        if (IS_CLASS(c, CHAR_ALPHA))
+        {
+            c = 'a';
         }
-        else if (content[i] == '/')
+        else if (IS_CLASS(c, CHAR_DIGIT))
         {
-            i += 1;
+            c = '0';
+        }
 
-            if (i < content_len && content[i] == '=')
+        switch (c)
+        {
+            case ' ': case '\t': case '\n': case '\v': case '\f': case '\r':
             {
-                i += 1;
-
-                tok = (struct token *)malloc(sizeof(struct token));
-                tok->type = TOK_BACKSLASH_EQUAL;
-
-                list_append(tokens, tok);
+                i = kernels->skip_space(content, i + 1, content_len);
+                leading |= TOKEN_SPACE;
+                if (memchr(&content[start], '\n', i - start) != NULL)
+                {
+                    leading |= TOKEN_BOL;
+                }
+                continue;
             }
-            else if (i < content_len && content[i] == '*')
+            case '\\':
             {
-                i += 1;
-
-                /* skip over comment contents */
-                while (i + 1 < content_len &&
-                       !(content[i] == '*' && content[i+1] == '/'))
+                /*
+                 * A backslash before a newline joins the two lines.
+                 */
+                i += next == '\n' ? 2 : 1;
+                continue;
+            }
+            case 'a':
+            {
+                do
                 {
                     i += 1;
-                }
-                /* consume the ending '*' and '/' characters */
-                if (i < content_len)
+                } while (i < content_len &&
+                         IS_CLASS(content[i], CHAR_IDENTIFIER));
+
+                /*
+                 * Check if this token is a reserved word. If not then consider
+                 * it a label.
+                 */
+                type = reserved_word_token(&content[start], i - start);
+                if (type == TOK_EOF)
                 {
-                    i += 2;
+                    type = TOK_IDENTIFIER;
+                    value = intern(&content[start], i - start);
                 }
+                break;
             }
-            else
+            case '0':
             {
-                tok = (struct token *)malloc(sizeof(struct token));
-                tok->type = TOK_BACKSLASH;
-
-                list_append(tokens, tok);
+                type = TOK_INTEGER;
+                i = scan_integer(content, i, content_len, &int_value, &flags);
+                break;
             }
-        }
-        else if (content[i] == '%')
-        {
-            i += 1;
+            case '"':
+            {
+                /*
+                 * consume characters up to the closing ", stepping over
+                 * anything escaped by a backslash
+                 */
+                i = kernels->string_special(content, i + 1, content_len);
+                while (i < content_len && content[i] == '\\')
+                {
+                    i = i + 2 < content_len ? i + 2 : content_len;
+                    i = kernels->string_special(content, i, content_len);
+                }
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_MOD;
+                type = TOK_STRING;
+                value = intern(&content[start + 1], i - start - 1);
 
-            if (i < content_len && content[i] == '=')
-            {
+                /* consume the closing " */
                 i += 1;
-                tok->type = TOK_MOD_EQUAL;
+                break;
             }
-
-            list_append(tokens, tok);
-        }
-        else if (content[i] == '>')
-        {
-            i += 1;
-
-            if (i < content_len && content[i] == '>')
+            case '/':
             {
-                i += 1;
-
-                tok = (struct token *)malloc(sizeof(struct token));
-                tok->type = TOK_SHIFTRIGHT;
+                if (next == '*')
+                {
+                    /* skip over comment contents and the closing star slash */
+                    i = kernels->comment_end(content, i + 2, content_len);
+                    i = i < content_len ? i + 2 : content_len;
+                    leading |= TOKEN_SPACE;
+                    if (memchr(&content[start], '\n', i - start) != NULL)
+                    {
+                        leading |= TOKEN_BOL;
+                    }
+                    continue;
+                }
+                if (next == '/')
+                {
+                    /* skip to the newline ending a line comment */
+                    end = memchr(&content[i], '\n', content_len - i);
+                    i = end != NULL ? (size_t)(end - content) : content_len;
+                    leading |= TOKEN_SPACE;
+                    continue;
+                }
 
-                list_append(tokens, tok);
+                type = TOK_BACKSLASH;
+                if (next == '=')
+                {
+                    type = TOK_BACKSLASH_EQUAL;
+                }
+                break;
             }
-            else if (i < content_len && content[i] == '=')
+            case '(': type = TOK_LPAREN; break;
+            case ')': type = TOK_RPAREN; break;
+            case '[': type = TOK_LBRACKET; break;
+            case ']': type = TOK_RBRACKET; break;
+            case '{': type = TOK_LBRACE; break;
+            case '}': type = TOK_RBRACE; break;
+            case ';': type = TOK_SEMICOLON; break;
+            case '\'': type = TOK_SINGLEQUOTE; break;
+            case '^': type = TOK_CARET; break;
+            case ',': type = TOK_COMMA; break;
+            case '?': type = TOK_QUESTIONMARK; break;
+            case ':': type = TOK_COLON; break;
+            case '#': type = TOK_HASH; break;
+            case '=':
             {
-                i += 1;
-
-                tok = (struct token *)malloc(sizeof(struct token));
-                tok->type = TOK_GREATERTHANEQUAL;
-
-                list_append(tokens, tok);
+                type = next == '=' ? TOK_EQ : TOK_EQUAL;
+                break;
             }
-            else
+            case '!':
             {
-                tok = (struct token *)malloc(sizeof(struct token));
-                tok->type = TOK_GREATERTHAN;
-
-                list_append(tokens, tok);
+                type = next == '=' ? TOK_NEQ : TOK_BANG;
+                break;
             }
-        }
-        else if (content[i] == '<')
-        {
-            i += 1;
-
-            if (i < content_len && content[i] == '<')
+            case '%':
             {
-                i += 1;
-
-                tok = (struct token *)malloc(sizeof(struct token));
-                tok->type = TOK_SHIFTLEFT;
-
-                list_append(tokens, tok);
+                type = next == '=' ? TOK_MOD_EQUAL : TOK_MOD;
+                break;
             }
-            else if (i < content_len && content[i] == '=')
+            case '*':
             {
-                i += 1;
-
-                tok = (struct token *)malloc(sizeof(struct token));
-                tok->type = TOK_LESSTHANEQUAL;
-
-                list_append(tokens, tok);
+                type = next == '=' ? TOK_ASTERISK_EQUAL : TOK_ASTERISK;
+                break;
             }
-            else
+            case '&':
             {
-                tok = (struct token *)malloc(sizeof(struct token));
-                tok->type = TOK_LESSTHAN;
-
-                list_append(tokens, tok);
+                type = next == '&' ? TOK_AMPERSAND_AMPERSAND : TOK_AMPERSAND;
+                break;
+            }
+            case '|':
+            {
+                type = next == '|' ? TOK_VERTICALBAR_VERTICALBAR :
+                                     TOK_VERTICALBAR;
+                break;
+            }
+            case '+':
+            {
+                type = next == '+' ? TOK_PLUS_PLUS :
+                       next == '=' ? TOK_PLUS_EQUAL : TOK_PLUS;
+                break;
+            }
+            case '-':
+            {
+                type = next == '-' ? TOK_MINUS_MINUS :
+                       next == '=' ? TOK_MINUS_EQUAL :
+                       next == '>' ? TOK_ARROW : TOK_MINUS;
+                break;
+            }
+            case '>':
+            {
+                type = next == '>' ? TOK_SHIFTRIGHT :
+                       next == '=' ? TOK_GREATERTHANEQUAL : TOK_GREATERTHAN;
+                break;
+            }
+            case '<':
+            {
+                type = next == '<' ? TOK_SHIFTLEFT :
+                       next == '=' ? TOK_LESSTHANEQUAL : TOK_LESSTHAN;
+                break;
+            }
+            case '.':
+            {
+                type = TOK_DOT;
+                if (next == '.' && i + 2 < content_len && content[i + 2] == '.')
+                {
+                    type = TOK_ELLIPSIS;
+                }
+                break;
+            }
+            default:
+            {
+                /*
+                 * Skip characters that don't start a token.
+                 */
+                i += 1;
+                continue;
             }
         }
-        else if (content[i] == '^')
-        {
-            i += 1;
-
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_CARET;
-
-            list_append(tokens, tok);
-        }
-        else if (content[i] == ',')
-        {
-            i += 1;
-
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_COMMA;
-
-            list_append(tokens, tok);
-        }
-        else if (content[i] == '?')
-        {
-            i += 1;
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_QUESTIONMARK;
-
-            list_append(tokens, tok);
-        }
-        else if (content[i] == ':')
-        {
-            i += 1;
+        /*
+         * Tokens break out of the switch with their type. Operators and
+         * punctuation haven't been consumed yet.
+         */
+        tok->type = type;
+        tok->value = value;
+        tok->int_value = int_value;
+        tok->flags = flags | leading;
+        tok->offset = start;
+        scanner->position = i + token_lengths[type + 1];
+        return;
+    }
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_COLON;
+    tok->type = TOK_EOF;
+    tok->value = NULL;
+    tok->int_value = 0;
+    tok->flags = leading;
+    tok->offset = content_len;
+    scanner->position = content_len;
+}
 
-            list_append(tokens, tok);
-        }
-        else if (content[i] == '|')
-        {
-            i += 1;
+struct token *
+next_token(struct scanner *scanner)
+{
+    if (scanner->peeked)
+    {
+        scanner->peeked = 0;
+    }
+    else
+    {
+        scan_token(scanner, &scanner->token);
+    }
+    return &scanner->token;
+}
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_VERTICALBAR;
+struct token *
+peek_token(struct scanner *scanner)
+{
+    if (!scanner->peeked)
+    {
+        scan_token(scanner, &scanner->token);
+        scanner->peeked = 1;
+    }
+    return &scanner->token;
+}
 
-            if (i < content_len && content[i] == '|')
-            {
-                i += 1;
-                tok->type = TOK_VERTICALBAR_VERTICALBAR;
-            }
+int
+report_malformed_token(const struct token *token)
+{
+    int errors = 0;
 
-            list_append(tokens, tok);
-        }
-        else if (content[i] == '.')
-        {
-            i += 1;
+    if (token->flags & TOKEN_BAD_DIGIT)
+    {
+        fprintf(stderr, "Invalid digit in octal constant at offset %zu\n",
+                token->offset);
+        errors++;
+    }
+    if (token->flags & TOKEN_NO_DIGITS)
+    {
+        fprintf(stderr, "Hexadecimal constant at offset %zu has no digits\n",
+                token->offset);
+        errors++;
+    }
+    if (token->flags & TOKEN_TOO_LARGE)
+    {
+        fprintf(stderr, "Integer constant at offset %zu is too large\n",
+                token->offset);
+        errors++;
+    }
 
-            tok = (struct token *)malloc(sizeof(struct token));
-            tok->type = TOK_DOT;
+    return errors;
+}
 
-            if (i < content_len + 2 && content[i] == '.' && content[i+1] == '.')
-            {
-                i += 2;
-                tok->type = TOK_ELLIPSIS;
-            }
+void
+scan(char *content, size_t content_len, struct token_buffer *tokens)
+{
+    struct scanner scanner;
+    struct token *tok;
 
-            list_append(tokens, tok);
-        }
-        else if (isspace(content[i]))
-        {
-            i += 1;
-        }
-    }
+    scanner_init(&scanner, content, content_len);
 
-    tok = (struct token *)malloc(sizeof(struct token));
-    tok->type = TOK_EOF;
-    list_append(tokens, tok);
+    do
+    {
+        tok = next_token(&scanner);
+        *token_buffer_push(tokens, tok->type, tok->offset) = *tok;
+    } while (tok->type != TOK_EOF);
 }
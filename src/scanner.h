@@ -53,6 +53,7 @@ enum token_t
     TOK_GREATERTHANEQUAL,
     TOK_EQ,
     TOK_NEQ,
+    TOK_HASH,
 
     /* reserved words */
     TOK_VOID,
@@ -88,17 +89,108 @@ enum token_t
     TOK_TYPEDEF,
 };
 
+/*
+ * Number of token types, including TOK_EOF.
+ */
+#define NUM_TOKENS (TOK_TYPEDEF + 2)
+
+/*
+ * Flags of a token. TOKEN_UNSIGNED, TOKEN_LONG and TOKEN_LONG_LONG record the
+ * suffixes of an integer constant. TOKEN_BOL is set on the first token of a
+ * line and TOKEN_SPACE on a token preceded by whitespace or a comment, which
+ * the preprocessor needs to find directives and function-like macros. The
+ * preprocessor marks parameters in macro bodies with TOKEN_PARAMETER, with
+ * their index in int_value, and names that must not be expanded again with
+ * TOKEN_NO_EXPAND. TOKEN_BAD_DIGIT, TOKEN_NO_DIGITS and TOKEN_TOO_LARGE mark
+ * malformed integer constants: octal constants with 8 or 9 in them,
+ * hexadecimal constants without digits and constants that don't fit in 64
+ * bits. The scanner doesn't report them, since it can't tell whether they are
+ * in a group the preprocessor skips; see report_malformed_token().
+ */
+#define TOKEN_UNSIGNED  0x1
+#define TOKEN_LONG      0x2
+#define TOKEN_LONG_LONG 0x4
+#define TOKEN_SUFFIXES  (TOKEN_UNSIGNED | TOKEN_LONG | TOKEN_LONG_LONG)
+#define TOKEN_BOL       0x8
+#define TOKEN_SPACE     0x10
+#define TOKEN_PARAMETER 0x20
+#define TOKEN_NO_EXPAND 0x40
+#define TOKEN_BAD_DIGIT 0x80
+#define TOKEN_NO_DIGITS 0x100
+#define TOKEN_TOO_LARGE 0x200
+#define TOKEN_MALFORMED (TOKEN_BAD_DIGIT | TOKEN_NO_DIGITS | TOKEN_TOO_LARGE)
+
+/*
+ * value is the interned text of identifiers and strings. int_value is the
+ * value of an integer constant, converted when it is scanned. offset is the
+ * position of the first character of the token in the source.
+ */
 struct token
 {
     enum token_t type;
-    char *value;
+    const char *value;
+    unsigned long long int_value;
+    int flags;
+    size_t offset;
+};
+
+/*
+ * token_buffer holds the tokens of a translation unit in a contiguous array
+ * allocated from the arena.
+ */
+struct token_buffer
+{
+    struct token *tokens;
+    size_t size;
+    size_t capacity;
+};
+
+#define TOKEN_BUFFER_INITIAL_CAPACITY 1024
+
+/*
+ * scanner produces the tokens of a string of code one at a time, so that the
+ * parser can pull them as it needs them instead of the whole translation unit
+ * being tokenized up front. token holds the last token scanned; peeked is set
+ * when it has been scanned by peek_token() but not yet returned by
+ * next_token().
+ */
+struct scanner
+{
+    char *content;
+    size_t content_len;
+    size_t position;
+    struct token token;
+    int peeked;
 };
 
-void preprocess(char *infile, char *outfile);
+void token_buffer_init(struct token_buffer *buffer);
+
+struct token *token_buffer_push(struct token_buffer *buffer, enum token_t type,
+                                size_t offset);
+
+void scanner_init(struct scanner *scanner, char *content, size_t content_len);
+
+/*
+ * Returns the next token and consumes it. After the end of the content every
+ * call returns TOK_EOF. The token is only valid until the next call.
+ */
+struct token *next_token(struct scanner *scanner);
+
+/*
+ * Returns the next token without consuming it.
+ */
+struct token *peek_token(struct scanner *scanner);
+
+/*
+ * Report to stderr how a token flagged with TOKEN_MALFORMED is malformed, and
+ * return the number of errors reported.
+ */
+int report_malformed_token(const struct token *token);
 
 /*
- * Given a string of code, constructs a list of tokens
+ * Given a string of code, appends its tokens to a token buffer. The last token
+ * is always TOK_EOF.
  */
-void scan(char *content, size_t content_len, struct listnode **tokens);
+void scan(char *content, size_t content_len, struct token_buffer *tokens);
 
 #endif
@@ -1,12 +1,29 @@
+#include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
 
 #include <check.h>
 
 #include "ast.h"
 #include "utilities.h"
 #include "scanner.h"
+#include "preprocessor.h"
 #include "parser.h"
 
+/*
+ * GENPT_PATH is the parse table generator built alongside the tests.
+ */
+#ifndef GENPT_PATH
+#define GENPT_PATH "./genpt"
+#endif
+
+/*
+ * PARSETABLE_PATH is the parse table file genpt wrote alongside the tests.
+ */
+#ifndef PARSETABLE_PATH
+#define PARSETABLE_PATH PARSETABLE_FILENAME
+#endif
+
 static void
 push_node_type_onto_stack(enum astnode_t type, struct listnode **stack)
 {
@@ -18,355 +35,688 @@ push_node_type_onto_stack(enum astnode_t type, struct listnode **stack)
     list_prepend(stack, node);
 }
 
-START_TEST(test_head_terminal_values_on_constant)
+START_TEST(test_first_set_on_constant)
 {
-    struct listnode *terminals, *checked_nodes;
-
-    list_init(&terminals);
-    list_init(&checked_nodes);
+    const struct lookahead *terminals;
 
-    head_terminal_values(AST_CONSTANT, &checked_nodes, &terminals);
+    terminals = first_set(AST_CONSTANT);
 
-    ck_assert_int_eq(AST_INTEGER_CONSTANT, (int)terminals->data);
-    ck_assert_int_eq(AST_CHARACTER_CONSTANT, (int)terminals->next->data);
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_INTEGER_CONSTANT));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_CHARACTER_CONSTANT));
 }
 END_TEST
 
-START_TEST(test_head_terminal_values_on_primary_expression)
+START_TEST(test_first_set_on_primary_expression)
 {
-    struct listnode *terminals, *checked_nodes;
+    const struct lookahead *terminals;
 
-    list_init(&terminals);
-    list_init(&checked_nodes);
+    terminals = first_set(AST_PRIMARY_EXPRESSION);
 
-    head_terminal_values(AST_PRIMARY_EXPRESSION, &checked_nodes, &terminals);
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_IDENTIFIER));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_INTEGER_CONSTANT));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_CHARACTER_CONSTANT));
+}
+END_TEST
 
-    ck_assert_int_eq(AST_IDENTIFIER, (int)terminals->data);
-    ck_assert_int_eq(AST_INTEGER_CONSTANT, (int)terminals->next->data);
-    ck_assert_int_eq(AST_CHARACTER_CONSTANT, (int)terminals->next->next->data);
+START_TEST(test_first_set_on_postfix_expression)
+{
+    const struct lookahead *terminals;
+
+    terminals = first_set(AST_POSTFIX_EXPRESSION);
+
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_IDENTIFIER));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_INTEGER_CONSTANT));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_CHARACTER_CONSTANT));
 }
 END_TEST
 
-START_TEST(test_head_terminal_values_on_postfix_expression)
+START_TEST(test_first_set_on_unary_expression)
 {
-    struct listnode *terminals, *checked_nodes;
+    const struct lookahead *terminals;
+
+    terminals = first_set(AST_UNARY_EXPRESSION);
+
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_PLUS_PLUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_MINUS_MINUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_AMPERSAND));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_ASTERISK));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_PLUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_MINUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_IDENTIFIER));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_INTEGER_CONSTANT));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_CHARACTER_CONSTANT));
+}
+END_TEST
 
-    list_init(&terminals);
-    list_init(&checked_nodes);
+START_TEST(test_first_set_on_cast_expression)
+{
+    const struct lookahead *terminals;
+
+    terminals = first_set(AST_CAST_EXPRESSION);
+
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_PLUS_PLUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_MINUS_MINUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_AMPERSAND));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_ASTERISK));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_PLUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_MINUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_IDENTIFIER));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_INTEGER_CONSTANT));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_CHARACTER_CONSTANT));
+}
+END_TEST
 
-    head_terminal_values(AST_POSTFIX_EXPRESSION, &checked_nodes, &terminals);
+START_TEST(test_first_set_on_multiplicative_expression)
+{
+    const struct lookahead *terminals;
+
+    terminals = first_set(AST_MULTIPLICATIVE_EXPRESSION);
+
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_PLUS_PLUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_MINUS_MINUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_AMPERSAND));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_ASTERISK));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_PLUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_MINUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_IDENTIFIER));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_INTEGER_CONSTANT));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_CHARACTER_CONSTANT));
+}
+END_TEST
 
-    ck_assert_int_eq(AST_IDENTIFIER, (int)terminals->data);
-    ck_assert_int_eq(AST_INTEGER_CONSTANT, (int)terminals->next->data);
-    ck_assert_int_eq(AST_CHARACTER_CONSTANT, (int)terminals->next->next->data);
+START_TEST(test_first_set_on_additive_expression)
+{
+    const struct lookahead *terminals;
+
+    terminals = first_set(AST_ADDITIVE_EXPRESSION);
+
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_PLUS_PLUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_MINUS_MINUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_AMPERSAND));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_ASTERISK));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_PLUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_MINUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_IDENTIFIER));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_INTEGER_CONSTANT));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_CHARACTER_CONSTANT));
 }
 END_TEST
 
-START_TEST(test_head_terminal_values_on_unary_expression)
+START_TEST(test_first_set_on_shift_expression)
 {
-    struct listnode *terminals, *checked_nodes;
+    const struct lookahead *terminals;
+
+    terminals = first_set(AST_SHIFT_EXPRESSION);
+
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_PLUS_PLUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_MINUS_MINUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_AMPERSAND));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_ASTERISK));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_PLUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_MINUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_IDENTIFIER));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_INTEGER_CONSTANT));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_CHARACTER_CONSTANT));
+}
+END_TEST
 
-    list_init(&terminals);
-    list_init(&checked_nodes);
+START_TEST(test_first_set_on_relational_expression)
+{
+    const struct lookahead *terminals;
+
+    terminals = first_set(AST_RELATIONAL_EXPRESSION);
+
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_PLUS_PLUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_MINUS_MINUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_AMPERSAND));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_ASTERISK));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_PLUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_MINUS));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_IDENTIFIER));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_INTEGER_CONSTANT));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_CHARACTER_CONSTANT));
+}
+END_TEST
 
-    head_terminal_values(AST_UNARY_EXPRESSION, &checked_nodes, &terminals);
+START_TEST(test_first_set_on_specifier_qualifier_list)
+{
+    const struct lookahead *terminals;
+
+    terminals = first_set(AST_SPECIFIER_QUALIFIER_LIST);
+
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_VOID));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_CHAR));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_SHORT));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_INT));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_LONG));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_FLOAT));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_DOUBLE));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_SIGNED));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_UNSIGNED));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_STRUCT));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_UNION));
+    ck_assert_int_eq(1, lookahead_contains(terminals, AST_ENUM));
 
-    ck_assert_int_eq(AST_PLUS_PLUS, (int)terminals->data);
-    ck_assert_int_eq(AST_MINUS_MINUS, (int)terminals->next->data);
-    ck_assert_int_eq(AST_AMPERSAND, (int)terminals->next->next->data);
-    ck_assert_int_eq(AST_ASTERISK, (int)terminals->next->next->next->data);
-    ck_assert_int_eq(AST_PLUS, (int)terminals->next->next->next->next->data);
-    ck_assert_int_eq(AST_MINUS, (int)terminals->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_IDENTIFIER, (int)terminals->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_INTEGER_CONSTANT, (int)terminals->next->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_CHARACTER_CONSTANT, (int)terminals->next->next->next->next->next->next->next->next->data);
+    // FIXME: update this test...
+    //ck_assert_int_eq(1, lookahead_contains(terminals, AST_CONST));
+    //ck_assert_int_eq(1, lookahead_contains(terminals, AST_VOLATILE));
 }
 END_TEST
 
-START_TEST(test_head_terminal_values_on_cast_expression)
+START_TEST(test_first_of_sequence_uses_follow_only_when_nullable)
 {
-    struct listnode *terminals, *checked_nodes;
+    struct lookahead follow, terminals;
+    enum astnode_t sequence[] = { AST_COMMA, AST_IDENTIFIER };
 
-    list_init(&terminals);
-    list_init(&checked_nodes);
+    memset(&follow, 0, sizeof(struct lookahead));
+    lookahead_add(&follow, AST_INVALID);
 
-    head_terminal_values(AST_CAST_EXPRESSION, &checked_nodes, &terminals);
+    first_of_sequence(sequence, 2, &follow, &terminals);
+    ck_assert_int_eq(1, lookahead_contains(&terminals, AST_COMMA));
+    ck_assert_int_eq(0, lookahead_contains(&terminals, AST_IDENTIFIER));
+    ck_assert_int_eq(0, lookahead_contains(&terminals, AST_INVALID));
 
-    ck_assert_int_eq(AST_PLUS_PLUS, (int)terminals->data);
-    ck_assert_int_eq(AST_MINUS_MINUS, (int)terminals->next->data);
-    ck_assert_int_eq(AST_AMPERSAND, (int)terminals->next->next->data);
-    ck_assert_int_eq(AST_ASTERISK, (int)terminals->next->next->next->data);
-    ck_assert_int_eq(AST_PLUS, (int)terminals->next->next->next->next->data);
-    ck_assert_int_eq(AST_MINUS, (int)terminals->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_IDENTIFIER, (int)terminals->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_INTEGER_CONSTANT, (int)terminals->next->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_CHARACTER_CONSTANT, (int)terminals->next->next->next->next->next->next->next->next->data);
+    first_of_sequence(sequence, 0, &follow, &terminals);
+    ck_assert_int_eq(1, lookahead_equal(&follow, &terminals));
+
+    ck_assert_int_eq(0, symbol_nullable(AST_TRANSLATION_UNIT));
 }
 END_TEST
 
-START_TEST(test_head_terminal_values_on_multiplicative_expression)
+START_TEST(test_lookahead_union_and_equal)
 {
-    struct listnode *terminals, *checked_nodes;
+    struct lookahead a, b;
+
+    memset(&a, 0, sizeof(struct lookahead));
+    memset(&b, 0, sizeof(struct lookahead));
 
-    list_init(&terminals);
-    list_init(&checked_nodes);
+    lookahead_add(&a, AST_CHARACTER_CONSTANT);
+    lookahead_add(&b, AST_INVALID);
+    ck_assert_int_eq(0, lookahead_equal(&a, &b));
 
-    head_terminal_values(AST_MULTIPLICATIVE_EXPRESSION, &checked_nodes, &terminals);
+    lookahead_union(&a, &b);
+    lookahead_add(&b, AST_CHARACTER_CONSTANT);
 
-    ck_assert_int_eq(AST_PLUS_PLUS, (int)terminals->data);
-    ck_assert_int_eq(AST_MINUS_MINUS, (int)terminals->next->data);
-    ck_assert_int_eq(AST_AMPERSAND, (int)terminals->next->next->data);
-    ck_assert_int_eq(AST_ASTERISK, (int)terminals->next->next->next->data);
-    ck_assert_int_eq(AST_PLUS, (int)terminals->next->next->next->next->data);
-    ck_assert_int_eq(AST_MINUS, (int)terminals->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_IDENTIFIER, (int)terminals->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_INTEGER_CONSTANT, (int)terminals->next->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_CHARACTER_CONSTANT, (int)terminals->next->next->next->next->next->next->next->next->data);
+    ck_assert_int_eq(1, lookahead_contains(&a, AST_CHARACTER_CONSTANT));
+    ck_assert_int_eq(1, lookahead_contains(&a, AST_INVALID));
+    ck_assert_int_eq(0, lookahead_contains(&a, AST_IDENTIFIER));
+    ck_assert_int_eq(1, lookahead_equal(&a, &b));
+    ck_assert_int_eq(lookahead_hash(&a), lookahead_hash(&b));
 }
 END_TEST
 
-START_TEST(test_head_terminal_values_on_additive_expression)
+START_TEST(test_generate_closure_on_constant)
 {
-    struct listnode *terminals, *checked_nodes;
+    struct closure closure;
+    struct lookahead lookahead;
+    memset(&closure, 0, sizeof(struct closure));
+    memset(&lookahead, 0, sizeof(struct lookahead));
+    lookahead_add(&lookahead, AST_SEMICOLON);
 
-    list_init(&terminals);
-    list_init(&checked_nodes);
+    generate_closure(AST_CONSTANT, &lookahead, &closure);
 
-    head_terminal_values(AST_ADDITIVE_EXPRESSION, &checked_nodes, &terminals);
-
-    ck_assert_int_eq(AST_PLUS_PLUS, (int)terminals->data);
-    ck_assert_int_eq(AST_MINUS_MINUS, (int)terminals->next->data);
-    ck_assert_int_eq(AST_AMPERSAND, (int)terminals->next->next->data);
-    ck_assert_int_eq(AST_ASTERISK, (int)terminals->next->next->next->data);
-    ck_assert_int_eq(AST_PLUS, (int)terminals->next->next->next->next->data);
-    ck_assert_int_eq(AST_MINUS, (int)terminals->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_IDENTIFIER, (int)terminals->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_INTEGER_CONSTANT, (int)terminals->next->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_CHARACTER_CONSTANT, (int)terminals->next->next->next->next->next->next->next->next->data);
+    ck_assert_int_eq(1, closure.contains[INDEX(AST_CONSTANT)]);
+    ck_assert_int_eq(0, closure.contains[INDEX(AST_PRIMARY_EXPRESSION)]);
+    ck_assert_int_eq(1, lookahead_equal(&lookahead, &closure.lookaheads[INDEX(AST_CONSTANT)]));
 }
 END_TEST
 
-START_TEST(test_head_terminal_values_on_shift_expression)
+START_TEST(test_generate_closure_on_primary_expression)
 {
-    struct listnode *terminals, *checked_nodes;
+    struct closure closure;
+    struct lookahead lookahead;
+    memset(&closure, 0, sizeof(struct closure));
+    memset(&lookahead, 0, sizeof(struct lookahead));
+
+    generate_closure(AST_PRIMARY_EXPRESSION, &lookahead, &closure);
+
+    ck_assert_int_eq(1, closure.contains[INDEX(AST_PRIMARY_EXPRESSION)]);
+    ck_assert_int_eq(1, closure.contains[INDEX(AST_CONSTANT)]);
+    ck_assert_int_eq(0, closure.contains[INDEX(AST_POSTFIX_EXPRESSION)]);
+    ck_assert_int_eq(0, closure.contains[INDEX(AST_EXPRESSION)]);
+}
+END_TEST
 
-    list_init(&terminals);
-    list_init(&checked_nodes);
+START_TEST(test_generate_closure_on_postfix_expression)
+{
+    struct closure closure;
+    struct lookahead lookahead;
+    memset(&closure, 0, sizeof(struct closure));
+    memset(&lookahead, 0, sizeof(struct lookahead));
 
-    head_terminal_values(AST_SHIFT_EXPRESSION, &checked_nodes, &terminals);
+    generate_closure(AST_POSTFIX_EXPRESSION, &lookahead, &closure);
 
-    ck_assert_int_eq(AST_PLUS_PLUS, (int)terminals->data);
-    ck_assert_int_eq(AST_MINUS_MINUS, (int)terminals->next->data);
-    ck_assert_int_eq(AST_AMPERSAND, (int)terminals->next->next->data);
-    ck_assert_int_eq(AST_ASTERISK, (int)terminals->next->next->next->data);
-    ck_assert_int_eq(AST_PLUS, (int)terminals->next->next->next->next->data);
-    ck_assert_int_eq(AST_MINUS, (int)terminals->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_IDENTIFIER, (int)terminals->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_INTEGER_CONSTANT, (int)terminals->next->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_CHARACTER_CONSTANT, (int)terminals->next->next->next->next->next->next->next->next->data);
+    /*
+     * postfix-expression is left recursive, so its items are also followed by
+     * the symbols that can come after it in its own rules.
+     */
+    ck_assert_int_eq(1, closure.contains[INDEX(AST_PRIMARY_EXPRESSION)]);
+    ck_assert_int_eq(1, lookahead_contains(&closure.lookaheads[INDEX(AST_POSTFIX_EXPRESSION)], AST_LPAREN));
+    ck_assert_int_eq(1, lookahead_contains(&closure.lookaheads[INDEX(AST_PRIMARY_EXPRESSION)], AST_ARROW));
 }
 END_TEST
 
-START_TEST(test_head_terminal_values_on_relational_expression)
+START_TEST(test_generate_closure_on_unary_expression)
 {
-    struct listnode *terminals, *checked_nodes;
+    struct closure closure;
+    struct lookahead lookahead;
+    memset(&closure, 0, sizeof(struct closure));
+    memset(&lookahead, 0, sizeof(struct lookahead));
 
-    list_init(&terminals);
-    list_init(&checked_nodes);
+    generate_closure(AST_UNARY_EXPRESSION, &lookahead, &closure);
 
-    head_terminal_values(AST_RELATIONAL_EXPRESSION, &checked_nodes, &terminals);
+    ck_assert_int_eq(1, closure.contains[INDEX(AST_UNARY_EXPRESSION)]);
+    ck_assert_int_eq(1, closure.contains[INDEX(AST_POSTFIX_EXPRESSION)]);
+    ck_assert_int_eq(1, closure.contains[INDEX(AST_CONSTANT)]);
 
-    ck_assert_int_eq(AST_PLUS_PLUS, (int)terminals->data);
-    ck_assert_int_eq(AST_MINUS_MINUS, (int)terminals->next->data);
-    ck_assert_int_eq(AST_AMPERSAND, (int)terminals->next->next->data);
-    ck_assert_int_eq(AST_ASTERISK, (int)terminals->next->next->next->data);
-    ck_assert_int_eq(AST_PLUS, (int)terminals->next->next->next->next->data);
-    ck_assert_int_eq(AST_MINUS, (int)terminals->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_IDENTIFIER, (int)terminals->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_INTEGER_CONSTANT, (int)terminals->next->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_CHARACTER_CONSTANT, (int)terminals->next->next->next->next->next->next->next->next->data);
+    /*
+     * cast-expression only follows a unary operator.
+     */
+    ck_assert_int_eq(0, closure.contains[INDEX(AST_CAST_EXPRESSION)]);
 }
 END_TEST
 
-START_TEST(test_head_terminal_values_on_specifier_qualifier_list)
+START_TEST(test_item_cores_are_dense)
 {
-    struct listnode *terminals, *checked_nodes;
+    struct rule *rule;
+    int core;
 
-    list_init(&terminals);
-    list_init(&checked_nodes);
+    rule = core_rule(0);
+    ck_assert_int_eq(0, item_core(rule, 0));
+    ck_assert_int_eq(1, item_core(rule, 1));
 
-    head_terminal_values(AST_SPECIFIER_QUALIFIER_LIST, &checked_nodes, &terminals);
+    for (core=0; core_rule(core)!=NULL; core++)
+    {
+        ck_assert_int_eq(core, item_core(core_rule(core), core_position(core)));
+    }
+    ck_assert(core <= MAX_CORES);
+}
+END_TEST
 
-    ck_assert_int_eq(AST_VOID, (int)terminals->data);
-    ck_assert_int_eq(AST_CHAR, (int)terminals->next->data);
-    ck_assert_int_eq(AST_SHORT, (int)terminals->next->next->data);
-    ck_assert_int_eq(AST_INT, (int)terminals->next->next->next->data);
-    ck_assert_int_eq(AST_LONG, (int)terminals->next->next->next->next->data);
-    ck_assert_int_eq(AST_FLOAT, (int)terminals->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_DOUBLE, (int)terminals->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_SIGNED, (int)terminals->next->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_UNSIGNED, (int)terminals->next->next->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_STRUCT, (int)terminals->next->next->next->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_UNION, (int)terminals->next->next->next->next->next->next->next->next->next->next->data);
-    ck_assert_int_eq(AST_ENUM, (int)terminals->next->next->next->next->next->next->next->next->next->next->next->data);
+START_TEST(test_generate_transitions_increments_cursor_position)
+{
+    struct state *state;
+    struct rule *rule;
+    struct kernel *next;
+    int core;
+    struct lookahead lookahead;
 
-    // FIXME: update this test...
-    //ck_assert_int_eq(AST_CONST, (int)terminals->next->next->next->next->next->next->next->next->next->next->next->next->data);
-    //ck_assert_int_eq(AST_VOLATILE, (int)terminals->next->next->next->next->next->next->next->next->next->next->next->next->next->data);
+    /*
+     * Find the rule constant: integer-constant.
+     */
+    for (core=0; (rule = core_rule(core))!=NULL; core++)
+    {
+        if (rule->type == AST_CONSTANT && core_position(core) == 0 &&
+            rule->nodes[0] == AST_INTEGER_CONSTANT)
+        {
+            break;
+        }
+    }
+    ck_assert_ptr_ne(NULL, rule);
+
+    state = malloc(sizeof(struct state));
+    memset(state, 0, sizeof(struct state));
+    memset(&lookahead, 0, sizeof(struct lookahead));
+    lookahead_add(&lookahead, AST_SEMICOLON);
+
+    state->kernel.size = 1;
+    state->kernel.cores = &core;
+    state->kernel.lookaheads = &lookahead;
+
+    generate_transitions(state);
+
+    /* next state should increment the cursor position */
+    next = &state->links[INDEX(AST_INTEGER_CONSTANT)]->kernel;
+    ck_assert_int_eq(1, next->size);
+    ck_assert_int_eq(core + 1, next->cores[0]);
+    ck_assert_int_eq(1, core_position(next->cores[0]));
+    ck_assert_int_eq(1, kernels_equal(next, next));
+    ck_assert_int_eq(1, lookahead_equal(&lookahead, &next->lookaheads[0]));
+
+    free(state);
 }
 END_TEST
 
-START_TEST(test_generate_items_on_constant)
+/*
+ * Read the parse table file written by genpt into contents and return its
+ * size.
+ */
+static size_t
+read_parsetable_file(char *contents, size_t capacity)
 {
-    struct listnode *items;
-    list_init(&items);
+    size_t size;
+    FILE *fp;
 
-    generate_items(AST_CONSTANT, NULL, &items);
+    fp = fopen(PARSETABLE_PATH, "rb");
+    ck_assert_ptr_ne(NULL, fp);
+    size = fread(contents, 1, capacity, fp);
+    fclose(fp);
+    ck_assert(size > sizeof(struct parsetable_header) && size < capacity);
 
-    ck_assert_int_eq(AST_INTEGER_CONSTANT, ((struct item *)items->data)->rewrite_rule->nodes[0]);
-    ck_assert_int_eq(0, ((struct item *)items->data)->cursor_position);
-    ck_assert_int_eq(AST_CHARACTER_CONSTANT, ((struct item *)items->next->data)->rewrite_rule->nodes[0]);
-    ck_assert_int_eq(0, ((struct item *)items->next->data)->cursor_position);
+    return size;
 }
-END_TEST
 
-START_TEST(test_generate_items_on_primary_expression)
+static void
+write_file(const char *filename, const char *contents, size_t size)
 {
-    struct listnode *items;
-    list_init(&items);
+    FILE *fp;
 
-    generate_items(AST_PRIMARY_EXPRESSION, NULL, &items);
+    fp = fopen(filename, "wb");
+    ck_assert_ptr_ne(NULL, fp);
+    fwrite(contents, 1, size, fp);
+    fclose(fp);
+}
 
-    ck_assert_int_eq(AST_IDENTIFIER, ((struct item *)items->data)->rewrite_rule->nodes[0]);
-    ck_assert_int_eq(0, ((struct item *)items->data)->cursor_position);
-    ck_assert_int_eq(AST_CONSTANT, ((struct item *)items->next->data)->rewrite_rule->nodes[0]);
-    ck_assert_int_eq(0, ((struct item *)items->next->data)->cursor_position);
-    ck_assert_int_eq(AST_INTEGER_CONSTANT, ((struct item *)items->next->next->data)->rewrite_rule->nodes[0]);
-    ck_assert_int_eq(0, ((struct item *)items->next->next->data)->cursor_position);
-    ck_assert_int_eq(AST_CHARACTER_CONSTANT, ((struct item *)items->next->next->next->data)->rewrite_rule->nodes[0]);
-    ck_assert_int_eq(0, ((struct item *)items->next->next->next->data)->cursor_position);
+START_TEST(test_load_parsetable_rejects_other_grammar)
+{
+    struct parsetable_header header;
+    static char contents[1 << 17];
+    size_t size;
+
+    /*
+     * Copy the parse table file with the grammar hash changed.
+     */
+    size = read_parsetable_file(contents, sizeof(contents));
+    memcpy(&header, contents, sizeof(struct parsetable_header));
+    ck_assert(header.grammar_hash == grammar_hash());
+    header.grammar_hash++;
+    memcpy(contents, &header, sizeof(struct parsetable_header));
+    write_file("/tmp/clink_test_parsetable.bin", contents, size);
+
+    ck_assert_int_eq(-1, load_parsetable("/tmp/clink_test_parsetable.bin"));
+    remove("/tmp/clink_test_parsetable.bin");
 }
 END_TEST
 
-static void
-assert_rules_equal(struct rule r1, struct rule r2)
+START_TEST(test_load_parsetable_rejects_corrupt_tables)
 {
-    int i;
+    struct parsetable_header header;
+    static char contents[1 << 17];
+    unsigned short *arrays, base;
+    size_t size;
+
+    size = read_parsetable_file(contents, sizeof(contents));
+    memcpy(&header, contents, sizeof(struct parsetable_header));
+    arrays = (unsigned short *)(contents + sizeof(struct parsetable_header));
+
+    /*
+     * A row of the ACTION table that runs past the end of its arrays.
+     */
+    base = arrays[header.states];
+    arrays[header.states] = header.action_size;
+    write_file("/tmp/clink_test_parsetable.bin", contents, size);
+    ck_assert_int_eq(-1, load_parsetable("/tmp/clink_test_parsetable.bin"));
+    arrays[header.states] = base;
+
+    /*
+     * A column of the GOTO table that runs past the end of its arrays.
+     */
+    arrays += 2 * header.states + 2 * header.action_size;
+    base = arrays[header.nonterminals];
+    arrays[header.nonterminals] = header.goto_size;
+    write_file("/tmp/clink_test_parsetable.bin", contents, size);
+    ck_assert_int_eq(-1, load_parsetable("/tmp/clink_test_parsetable.bin"));
+    arrays[header.nonterminals] = base;
 
-    ck_assert_int_eq(r1.type, r2.type);
-    ck_assert_int_eq(r1.length_of_nodes, r2.length_of_nodes);
+    /*
+     * The file is fine once they are put back.
+     */
+    write_file("/tmp/clink_test_parsetable.bin", contents, size);
+    ck_assert_int_eq(0, load_parsetable("/tmp/clink_test_parsetable.bin"));
+    ck_assert_int_eq(0, load_parsetable(NULL));
+    remove("/tmp/clink_test_parsetable.bin");
+}
+END_TEST
+
+START_TEST(test_grammar_hash_covers_elided_rules)
+{
+    struct rule *rule;
+    unsigned long hash;
+    int core;
 
-    for (i=0; i<r1.length_of_nodes; i++)
+    for (core=0; (rule = core_rule(core))!=NULL; core++)
     {
-        ck_assert_int_eq(r1.nodes[i], r2.nodes[i]);
+        if (rule->create == create_elided_node)
+        {
+            break;
+        }
     }
+    ck_assert_ptr_ne(NULL, rule);
+
+    /*
+     * A table that skips the reductions of a rule can't be used once the
+     * rule creates its own node.
+     */
+    hash = grammar_hash();
+    rule->create = create_translation_unit_node;
+    ck_assert(hash != grammar_hash());
+    rule->create = create_elided_node;
+    ck_assert(hash == grammar_hash());
 }
+END_TEST
 
-START_TEST(test_generate_items_on_postfix_expression)
+START_TEST(test_genpt_elides_unit_rules_from_clr_table)
 {
-    struct listnode *items;
-    list_init(&items);
+    struct parsetable_header header;
+    char directory[] = "/tmp/clink_test_XXXXXX";
+    char command[512], path[512];
+    FILE *fp;
 
-    generate_items(AST_POSTFIX_EXPRESSION, NULL, &items);
+    /*
+     * Eliding unit rules from the canonical table adds several times as many
+     * states as it does to the LALR(1) table.
+     */
+    ck_assert_ptr_ne(NULL, mkdtemp(directory));
+    snprintf(command, sizeof(command),
+             "cd %s && %s --elide-unit-rules --no-cache >/dev/null",
+             directory, GENPT_PATH);
+    ck_assert_int_eq(0, system(command));
+
+    snprintf(path, sizeof(path), "%s/%s", directory, PARSETABLE_FILENAME);
+    fp = fopen(path, "rb");
+    ck_assert_ptr_ne(NULL, fp);
+    ck_assert_int_eq(1, fread(&header, sizeof(header), 1, fp));
+    fclose(fp);
+
+    ck_assert(header.grammar_hash == grammar_hash());
+    ck_assert(header.states > 0);
+    ck_assert_int_eq(1, header.elided);
+
+    remove(path);
+    snprintf(path, sizeof(path), "%s/parsetable.h", directory);
+    remove(path);
+    rmdir(directory);
+}
+END_TEST
+
+START_TEST(test_parsetable_action_in_initial_state)
+{
+    unsigned short action;
 
-    assert_rules_equal(
-        (struct rule) { AST_POSTFIX_EXPRESSION, create_, 3, { AST_POSTFIX_EXPRESSION, AST_LPAREN, AST_RPAREN } },
-        *((struct item *)items->data)->rewrite_rule);
+    /*
+     * A declaration can begin with a type specifier but not a closing brace.
+     */
+    action = parsetable_action(0, AST_INT);
+    ck_assert_int_eq(ACTION_SHIFT, action & ACTION_SHIFT);
+    ck_assert_int_eq(0, action & ACTION_REDUCE);
 
-    assert_rules_equal(
-        (struct rule) { AST_POSTFIX_EXPRESSION, create_, 3, { AST_POSTFIX_EXPRESSION, AST_LPAREN, AST_RPAREN } },
-        *((struct item *)items->next->data)->rewrite_rule);
-    ck_assert_int_eq(AST_LPAREN, (int)((struct item *)items->next->data)->lookahead->data);
+    ck_assert_int_eq(0, parsetable_action(0, AST_RBRACE));
 }
 END_TEST
 
-START_TEST(test_generate_items_on_unary_expression)
+START_TEST(test_load_parsetable_matches_compiled_table)
 {
-    struct listnode *items;
-    list_init(&items);
+    unsigned short action;
+
+    ck_assert_int_eq(-1, load_parsetable("missing-parsetable.bin"));
+
+    action = parsetable_action(0, AST_INT);
 
-    generate_items(AST_UNARY_EXPRESSION, NULL, &items);
+    /*
+     * genpt writes the parse table file alongside parsetable.h.
+     */
+    ck_assert_int_eq(0, load_parsetable(PARSETABLE_PATH));
+    ck_assert_int_eq(action, parsetable_action(0, AST_INT));
+    ck_assert_int_eq(0, parsetable_action(0, AST_RBRACE));
 
-    assert_rules_equal(
-        (struct rule){ AST_UNARY_EXPRESSION, create_, 2, { AST_PLUS_PLUS, AST_UNARY_EXPRESSION } },
-        *((struct item *)items->data)->rewrite_rule);
-    assert_rules_equal(
-        (struct rule){ AST_UNARY_EXPRESSION, create_, 2, { AST_MINUS_MINUS, AST_UNARY_EXPRESSION } },
-        *((struct item *)items->next->data)->rewrite_rule);
-    assert_rules_equal(
-        (struct rule){ AST_UNARY_EXPRESSION, create_, 2, { AST_AMPERSAND, AST_CAST_EXPRESSION } },
-        *((struct item *)items->next->next->data)->rewrite_rule);
-    assert_rules_equal(
-        (struct rule){ AST_UNARY_EXPRESSION, create_, 2, { AST_ASTERISK, AST_CAST_EXPRESSION } },
-        *((struct item *)items->next->next->next->data)->rewrite_rule);
+    ck_assert_int_eq(0, load_parsetable(NULL));
+    ck_assert_int_eq(action, parsetable_action(0, AST_INT));
 }
 END_TEST
 
-START_TEST(test_generate_transitions_increments_cursor_position)
+START_TEST(test_token_to_astnode)
 {
-    struct state *state;
-    struct item *item;
+    struct token token;
 
-    state = malloc(sizeof(struct state));;
-    memset(state, 0, sizeof(struct state));
+    token.value = NULL;
 
-    item = malloc(sizeof(struct item));;
-    item->rewrite_rule = &(struct rule) { AST_CONSTANT, create_, 1, { AST_INTEGER_CONSTANT} };
-    item->cursor_position = 0;
+    token.type = TOK_INTEGER;
+    ck_assert_int_eq(AST_INTEGER_CONSTANT, token_to_astnode(&token)->type);
+    token.offset = 7;
+    ck_assert_ptr_ne(&token, token_to_astnode(&token)->token);
+    ck_assert_int_eq(7, token_to_astnode(&token)->token->offset);
 
-    list_append(&state->items, item);
+    token.type = TOK_DOT;
+    ck_assert_int_eq(AST_DOT, token_to_astnode(&token)->type);
 
-    generate_transitions(state);
+    /*
+     * Only terminals the AST reads keep a copy of their token.
+     */
+    ck_assert_ptr_eq(NULL, token_to_astnode(&token)->token);
 
-    /* next state should increment the cursor position */
-    ck_assert_int_eq(1, ((struct item *)(state->links[INDEX(AST_INTEGER_CONSTANT)]->items->data))->cursor_position);
+    token.type = TOK_ARROW;
+    ck_assert_int_eq(AST_ARROW, token_to_astnode(&token)->type);
+
+    token.type = TOK_TYPEDEF;
+    ck_assert_int_eq(AST_TYPEDEF, token_to_astnode(&token)->type);
+
+    token.type = TOK_EOF;
+    ck_assert_int_eq(AST_INVALID, token_to_astnode(&token)->type);
+
+    /*
+     * Tokens the grammar does not use are unknown, not end of input.
+     */
+    token.type = TOK_BANG;
+    ck_assert_int_eq(AST_UNKNOWN_TOKEN, token_to_astnode(&token)->type);
+    token.type = TOK_HASH;
+    ck_assert_int_eq(AST_UNKNOWN_TOKEN, token_to_astnode(&token)->type);
 }
 END_TEST
 
 START_TEST(test_parser_can_parse_simple_declaration)
 {
     struct astnode *ast;
-    struct listnode *tokens;
+    struct preprocessor preprocessor;
     char *content;
-    list_init(&tokens);
 
     /*
      * parse global variable declaration
      */
     content = "int identifier;";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 
-    list_init(&tokens);
-
     /*
      * parse global variable declaration with multiple specifiers
      */
     content = "static int identifier;";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 }
 END_TEST
 
+START_TEST(test_parser_gives_elided_nodes_their_types)
+{
+    struct ast_translation_unit *ast;
+    struct preprocessor preprocessor;
+    char directory[] = "/tmp/clink_test_XXXXXX";
+    char command[512], path[512];
+    char *content;
+
+    /*
+     * external-declaration: declaration is elided, whether or not the parse
+     * table skips its reduction.
+     */
+    content = "int identifier;";
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+
+    ast = (struct ast_translation_unit *)parse(&preprocessor);
+    ck_assert_int_eq(1, ast->translation_unit_items_size);
+    ck_assert_int_eq(AST_EXTERNAL_DECLARATION,
+                     ast->translation_unit_items[0]->type);
+    ck_assert_int_eq(AST_DECLARATION,
+                     ast->translation_unit_items[0]->elided_type);
+
+    /*
+     * A table that skips the reduction gives the node the same types.
+     */
+    ck_assert_ptr_ne(NULL, mkdtemp(directory));
+    snprintf(command, sizeof(command),
+             "cd %s && %s --lalr --elide-unit-rules --no-cache >/dev/null",
+             directory, GENPT_PATH);
+    ck_assert_int_eq(0, system(command));
+
+    snprintf(path, sizeof(path), "%s/%s", directory, PARSETABLE_FILENAME);
+    ck_assert_int_eq(0, load_parsetable(path));
+
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+    ast = (struct ast_translation_unit *)parse(&preprocessor);
+    ck_assert_int_eq(0, load_parsetable(NULL));
+
+    ck_assert_int_eq(1, ast->translation_unit_items_size);
+    ck_assert_int_eq(AST_EXTERNAL_DECLARATION,
+                     ast->translation_unit_items[0]->type);
+    ck_assert_int_eq(AST_DECLARATION,
+                     ast->translation_unit_items[0]->elided_type);
+
+    remove(path);
+    snprintf(path, sizeof(path), "%s/parsetable.h", directory);
+    remove(path);
+    rmdir(directory);
+}
+END_TEST
+
+START_TEST(test_parser_reports_syntax_errors)
+{
+    struct preprocessor preprocessor;
+    char *content;
+
+    /*
+     * Tokens the grammar has no terminal for are syntax errors, not the end
+     * of input.
+     */
+    content = "int main() { int x; x = !0; }";
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+    ck_assert_ptr_eq(NULL, parse(&preprocessor));
+
+    content = "int x";
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+    ck_assert_ptr_eq(NULL, parse(&preprocessor));
+
+    content = "int x; }";
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+    ck_assert_ptr_eq(NULL, parse(&preprocessor));
+}
+END_TEST
+
 START_TEST(test_parser_can_parse_multiple_simple_declarations)
 {
     struct astnode *ast;
-    struct listnode *tokens;
+    struct preprocessor preprocessor;
     char *content;
-    list_init(&tokens);
 
     /*
      * parse global variable declaration
      */
     content = "int identifier;"
               "long identifier;";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 }
 END_TEST
@@ -374,9 +724,8 @@ END_TEST
 START_TEST(test_parser_can_parse_primary_expressions)
 {
     struct astnode *ast;
-    struct listnode *tokens;
+    struct preprocessor preprocessor;
     char *content;
-    list_init(&tokens);
 
     /*
      * parse primary expression with parens
@@ -385,9 +734,9 @@ START_TEST(test_parser_can_parse_primary_expressions)
               "{"
               "    return (1 + 2) * 3;"
               "}";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 }
 END_TEST
@@ -395,9 +744,8 @@ END_TEST
 START_TEST(test_parser_can_parse_function)
 {
     struct astnode *ast;
-    struct listnode *tokens;
+    struct preprocessor preprocessor;
     char *content;
-    list_init(&tokens);
 
     /*
      * parse empty function
@@ -405,15 +753,14 @@ START_TEST(test_parser_can_parse_function)
     content = "char function()"
               "{"
               "}";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 
     /*
      * parse function with variable declarations and for loop
      */
-    list_init(&tokens);
     content = "char function()"
               "{"
               "    int identifier;"
@@ -422,53 +769,50 @@ START_TEST(test_parser_can_parse_function)
               "    {"
               "    }"
               "}";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 
     /*
      * parse function for loop with parameters
      */
-    list_init(&tokens);
     content = "char function(int i)"
               "{"
               "    for (i=1;i<5;i++)"
               "    {"
               "    }"
               "}";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 
     /*
      * parse function while loop
      */
-    list_init(&tokens);
     content = "char function(char a, char b)"
               "{"
               "    while (a == b)"
               "    {"
               "    }"
               "}";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 
     /*
      * parse function goto
      */
-    list_init(&tokens);
     content = "char function()"
               "{"
               "label1:"
               "    goto label1;"
               "}";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 }
 END_TEST
@@ -476,9 +820,8 @@ END_TEST
 START_TEST(test_parser_can_parse_function_calls)
 {
     struct astnode *ast;
-    struct listnode *tokens;
+    struct preprocessor preprocessor;
     char *content;
-    list_init(&tokens);
 
     /*
      * function with no parameters
@@ -487,35 +830,33 @@ START_TEST(test_parser_can_parse_function_calls)
               "{"
               "    afunction();"
               "}";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 
     /*
      * function with literal arguments
      */
-    list_init(&tokens);
     content = "char function()"
               "{"
               "    bfunction(1, 2);"
               "}";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 
     /*
      * function with argument variables
      */
-    list_init(&tokens);
     content = "char function()"
               "{"
               "    cfunction(myargument);"
               "}";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 }
 END_TEST
@@ -523,17 +864,16 @@ END_TEST
 START_TEST(test_parser_can_parse_function_prototype)
 {
     struct astnode *ast;
-    struct listnode *tokens;
+    struct preprocessor preprocessor;
     char *content;
-    list_init(&tokens);
 
     /*
      * parse empty function
      */
     content = "char function(int a, char *s);";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 }
 END_TEST
@@ -541,31 +881,29 @@ END_TEST
 START_TEST(test_parser_can_parse_struct)
 {
     struct astnode *ast;
-    struct listnode *tokens;
+    struct preprocessor preprocessor;
     char *content;
-    list_init(&tokens);
 
     /*
      * parse empty struct
      */
     content = "struct identifier;";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 
     /*
      * parse simple struct
      */
-    list_init(&tokens);
     content = "struct identifier"
               "{"
               "    int identifier;"
               "    char identifier;"
               "};";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 }
 END_TEST
@@ -573,29 +911,27 @@ END_TEST
 START_TEST(test_parser_can_parse_arrays)
 {
     struct astnode *ast;
-    struct listnode *tokens;
+    struct preprocessor preprocessor;
     char *content;
-    list_init(&tokens);
 
     /*
      * parse basic array
      */
     content = "int an_array[42];"
               "int another_array[size * 2];";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 
     /*
      * parse multi-dimensional array
      */
-    list_init(&tokens);
     content = "int a_multi_dimensional_array[42][2];"
               "int another_multi_dimensional_array[size*2][size*2];";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 }
 END_TEST
@@ -603,9 +939,8 @@ END_TEST
 START_TEST(test_parser_can_parse_arithmatic_statements)
 {
     struct astnode *ast;
-    struct listnode *tokens;
+    struct preprocessor preprocessor;
     char *content;
-    list_init(&tokens);
 
     /*
      * parse expressions
@@ -615,9 +950,9 @@ START_TEST(test_parser_can_parse_arithmatic_statements)
               "    int a;"
               "    a = b + c * d;"
               "}";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 }
 END_TEST
@@ -625,9 +960,8 @@ END_TEST
 START_TEST(test_parser_can_parse_conditional_statements)
 {
     struct astnode *ast;
-    struct listnode *tokens;
+    struct preprocessor preprocessor;
     char *content;
-    list_init(&tokens);
 
     /*
      * parse expressions
@@ -662,15 +996,14 @@ START_TEST(test_parser_can_parse_conditional_statements)
               "        }"
               "    }"
               "}";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 
     /*
      * switch case statements
      */
-    list_init(&tokens);
     content = "char function()"
               "{"
               "    /* switch case statement */"
@@ -683,9 +1016,9 @@ START_TEST(test_parser_can_parse_conditional_statements)
               "        }"
               "    }"
               "}";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 }
 END_TEST
@@ -693,9 +1026,8 @@ END_TEST
 START_TEST(test_parser_can_parse_assigment_operations)
 {
     struct astnode *ast;
-    struct listnode *tokens;
+    struct preprocessor preprocessor;
     char *content;
-    list_init(&tokens);
 
     /*
      * assigment operations
@@ -709,13 +1041,71 @@ START_TEST(test_parser_can_parse_assigment_operations)
               "    a /= b;"
               "    a %= b;"
               "}";
-    scan(content, strlen(content), &tokens);
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+
+    ast = parse(&preprocessor);
+    ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
+}
+END_TEST
+
+START_TEST(test_parser_can_parse_deeply_nested_expressions)
+{
+    struct astnode *ast;
+    struct preprocessor preprocessor;
+    char content[2048];
+    int i, length = 0;
+
+    /*
+     * Nesting deeper than the initial parse stack capacity grows the stack.
+     */
+    length += sprintf(content + length, "int function() { return ");
+    for (i=0; i<300; i++)
+    {
+        content[length++] = '(';
+    }
+    content[length++] = '1';
+    for (i=0; i<300; i++)
+    {
+        content[length++] = ')';
+    }
+    length += sprintf(content + length, "; }");
+    preprocessor_init(&preprocessor, NULL, content, length);
 
-    ast = parse(tokens);
+    ast = parse(&preprocessor);
     ck_assert_int_eq(AST_TRANSLATION_UNIT, ast->type);
 }
 END_TEST
 
+START_TEST(test_create_binary_op_reads_children_in_rule_order)
+{
+    struct rule rule =
+    {
+        AST_EQUALITY_EXPRESSION,
+        create_binary_op,
+        3,
+        { AST_EQUALITY_EXPRESSION, AST_EQ, AST_RELATIONAL_EXPRESSION }
+    };
+    struct astnode left, op, right;
+    struct astnode *rhs[3];
+    struct ast_binary_op *node;
+
+    memset(&left, 0, sizeof(struct astnode));
+    memset(&op, 0, sizeof(struct astnode));
+    memset(&right, 0, sizeof(struct astnode));
+    op.type = AST_EQ;
+
+    rhs[0] = &left;
+    rhs[1] = &op;
+    rhs[2] = &right;
+
+    node = (struct ast_binary_op *)rule.create(rhs, &rule);
+    ck_assert_int_eq(AST_EQUALITY_EXPRESSION, node->type);
+    ck_assert_int_eq(AST_EQ, node->op);
+    ck_assert_ptr_eq(&left, node->left);
+    ck_assert_ptr_eq(&right, node->right);
+}
+END_TEST
+
 START_TEST(test_list_append)
 {
     struct listnode *a_list;
@@ -745,224 +1135,785 @@ START_TEST(test_list_item)
 }
 END_TEST
 
+START_TEST(test_arena_alloc_is_zeroed_and_aligned)
+{
+    char *a, *b, *large;
+
+    a = arena_alloc(3);
+    b = arena_alloc(5);
+    ck_assert_int_eq(0, (unsigned long)a % ARENA_ALIGNMENT);
+    ck_assert_int_eq(0, (unsigned long)b % ARENA_ALIGNMENT);
+    ck_assert_int_eq(0, a[0] | a[1] | a[2]);
+    ck_assert(b >= a + 3);
+
+    large = arena_alloc(ARENA_CHUNK_SIZE * 2);
+    ck_assert_int_eq(0, large[ARENA_CHUNK_SIZE * 2 - 1]);
+
+    ck_assert_str_eq("abc", arena_strndup("abcdef", 3));
+
+    arena_release();
+}
+END_TEST
+
+START_TEST(test_arena_realloc_keeps_contents)
+{
+    char *a, *b;
+
+    a = arena_strndup("123", 3);
+
+    /*
+     * The most recent allocation grows in place.
+     */
+    b = arena_realloc(a, 4, 64);
+    ck_assert_ptr_eq(a, b);
+
+    arena_alloc(1);
+
+    /*
+     * Others are copied.
+     */
+    b = arena_realloc(a, 4, 128);
+    ck_assert(a != b);
+    ck_assert_str_eq("123", b);
+
+    arena_release();
+}
+END_TEST
+
+START_TEST(test_intern_returns_shared_strings)
+{
+    const char *a, *b, *c;
+    char name[16];
+    int i;
+
+    a = intern("identifier", 10);
+    b = intern("identifier_suffix", 10);
+    c = intern("identify", 8);
+
+    ck_assert_ptr_eq(a, b);
+    ck_assert(a != c);
+    ck_assert_str_eq("identifier", a);
+
+    /*
+     * Strings stay interned while the table grows.
+     */
+    for (i=0; i<INTERN_TABLE_INITIAL_SIZE; i++)
+    {
+        snprintf(name, sizeof(name), "name%d", i);
+        intern(name, strlen(name));
+    }
+    ck_assert_ptr_eq(a, intern("identifier", 10));
+
+    arena_release();
+}
+END_TEST
+
+START_TEST(test_scanner_interns_identifiers)
+{
+    char *content = "count = count + total;";
+    struct token_buffer tokens;
+    struct token *first, *second, *third;
+    token_buffer_init(&tokens);
+
+    scan(content, strlen(content), &tokens);
+
+    first = &tokens.tokens[0];
+    second = &tokens.tokens[2];
+    third = &tokens.tokens[4];
+    ck_assert_ptr_eq(first->value, second->value);
+    ck_assert(first->value != third->value);
+    ck_assert_str_eq("total", third->value);
+}
+END_TEST
+
+START_TEST(test_scanner_records_token_offsets)
+{
+    char *content = "int  x = 42;";
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
+
+    scan(content, strlen(content), &tokens);
+
+    ck_assert_int_eq(6, tokens.size);
+    ck_assert_int_eq(0, tokens.tokens[0].offset);
+    ck_assert_int_eq(5, tokens.tokens[1].offset);
+    ck_assert_int_eq(7, tokens.tokens[2].offset);
+    ck_assert_int_eq(9, tokens.tokens[3].offset);
+    ck_assert_int_eq(11, tokens.tokens[4].offset);
+    ck_assert_int_eq(TOK_EOF, tokens.tokens[5].type);
+    ck_assert_int_eq(strlen(content), tokens.tokens[5].offset);
+}
+END_TEST
+
+START_TEST(test_scanner_skips_unknown_characters_and_whitespace_runs)
+{
+    char *content = "a @\t\r\n  ...b.c $";
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
+
+    scan(content, strlen(content), &tokens);
+
+    ck_assert_int_eq(6, tokens.size);
+    ck_assert_int_eq(TOK_IDENTIFIER, tokens.tokens[0].type);
+    ck_assert_int_eq(TOK_ELLIPSIS, tokens.tokens[1].type);
+    ck_assert_int_eq(8, tokens.tokens[1].offset);
+    ck_assert_int_eq(TOK_IDENTIFIER, tokens.tokens[2].type);
+    ck_assert_int_eq(TOK_DOT, tokens.tokens[3].type);
+    ck_assert_int_eq(TOK_IDENTIFIER, tokens.tokens[4].type);
+    ck_assert_str_eq("c", tokens.tokens[4].value);
+    ck_assert_int_eq(TOK_EOF, tokens.tokens[5].type);
+}
+END_TEST
+
+START_TEST(test_scanner_skips_long_comments_whitespace_and_strings)
+{
+    char content[512];
+    struct token_buffer tokens;
+    size_t i, length;
+
+    /*
+     * Runs longer than a vector register, with the interesting bytes placed
+     * at every offset from the start of a run.
+     */
+    for (i = 0; i < 40; i++)
+    {
+        length = 0;
+        memset(&content[length], ' ', i + 1);
+        length += i + 1;
+        memcpy(&content[length], "/*", 2);
+        length += 2;
+        memset(&content[length], '*', i);
+        length += i;
+        memcpy(&content[length], "*/\t\n", 4);
+        length += 4;
+        memset(&content[length], '\n', 40);
+        length += 40;
+        content[length++] = '"';
+        memset(&content[length], 'x', i);
+        length += i;
+        memcpy(&content[length], "\\\"y\";", 5);
+        length += 5;
+
+        token_buffer_init(&tokens);
+        scan(content, length, &tokens);
+
+        ck_assert_int_eq(3, tokens.size);
+        ck_assert_int_eq(TOK_STRING, tokens.tokens[0].type);
+        ck_assert_int_eq(i + 2 + 1, strlen(tokens.tokens[0].value));
+        ck_assert_int_eq(TOK_SEMICOLON, tokens.tokens[1].type);
+        ck_assert_int_eq(length - 1, tokens.tokens[1].offset);
+        ck_assert_int_eq(TOK_EOF, tokens.tokens[2].type);
+    }
+}
+END_TEST
+
+START_TEST(test_scanner_produces_tokens_on_demand)
+{
+    char *content = "x = 1;";
+    struct scanner scanner;
+    struct token *token;
+
+    scanner_init(&scanner, content, strlen(content));
+
+    token = peek_token(&scanner);
+    ck_assert_int_eq(TOK_IDENTIFIER, token->type);
+    ck_assert_int_eq(1, scanner.position);
+
+    token = next_token(&scanner);
+    ck_assert_int_eq(TOK_IDENTIFIER, token->type);
+    ck_assert_str_eq("x", token->value);
+
+    ck_assert_int_eq(TOK_EQUAL, next_token(&scanner)->type);
+    ck_assert_int_eq(TOK_INTEGER, peek_token(&scanner)->type);
+    ck_assert_int_eq(TOK_INTEGER, next_token(&scanner)->type);
+    ck_assert_int_eq(TOK_SEMICOLON, next_token(&scanner)->type);
+
+    token = next_token(&scanner);
+    ck_assert_int_eq(TOK_EOF, token->type);
+    ck_assert_int_eq(strlen(content), token->offset);
+    ck_assert_int_eq(TOK_EOF, next_token(&scanner)->type);
+}
+END_TEST
+
+START_TEST(test_preprocessor_expands_macros_and_conditionals)
+{
+    char *content = "#define N 3\n"
+                    "#define ADD(a, b) a + b\n"
+                    "#define EMPTY\n"
+                    "#if defined(N) && N > 2\n"
+                    "int x = ADD(N, 1) EMPTY;\n"
+                    "#elif 1\n"
+                    "int y;\n"
+                    "#else\n"
+                    "int z;\n"
+                    "#endif\n"
+                    "#undef N\n"
+                    "#ifdef N\n"
+                    "int v;\n"
+                    "#endif\n"
+                    "#define f(x) x + f(x)\n"
+                    "#define Z() 0\n"
+                    "f(N) f Z()\n";
+    enum token_t expected[] = {
+        TOK_INT, TOK_IDENTIFIER, TOK_EQUAL, TOK_INTEGER, TOK_PLUS,
+        TOK_INTEGER, TOK_SEMICOLON, TOK_IDENTIFIER, TOK_PLUS, TOK_IDENTIFIER,
+        TOK_LPAREN, TOK_IDENTIFIER, TOK_RPAREN, TOK_IDENTIFIER, TOK_INTEGER,
+        TOK_EOF
+    };
+    struct preprocessor preprocessor;
+    struct token *tok;
+    size_t i;
+
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+
+    for (i=0; i<sizeof(expected)/sizeof(expected[0]); i++)
+    {
+        tok = preprocessor_next(&preprocessor);
+        ck_assert_int_eq(expected[i], tok->type);
+
+        if (i == 3)
+        {
+            ck_assert_int_eq(3, tok->int_value);
+        }
+        else if (i == 9)
+        {
+            /*
+             * f is not expanded again inside its own expansion.
+             */
+            ck_assert_str_eq("f", tok->value);
+        }
+    }
+    ck_assert_int_eq(0, preprocessor.errors);
+}
+END_TEST
+
+START_TEST(test_preprocessor_rescans_expansions_with_following_tokens)
+{
+    char *content = "#define f(x) x * 2\n"
+                    "#define g f\n"
+                    "#define id(x) x\n"
+                    "#define loop loop\n"
+                    "g(3) id(id(4)) loop";
+    enum token_t expected[] = {
+        TOK_INTEGER, TOK_ASTERISK, TOK_INTEGER, TOK_INTEGER, TOK_IDENTIFIER,
+        TOK_EOF
+    };
+    struct preprocessor preprocessor;
+    struct token *tok;
+    size_t i;
+
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+
+    for (i=0; i<sizeof(expected)/sizeof(expected[0]); i++)
+    {
+        tok = preprocessor_next(&preprocessor);
+        ck_assert_int_eq(expected[i], tok->type);
+    }
+
+    /*
+     * Nothing is left on the expansion stack.
+     */
+    ck_assert_int_eq(0, preprocessor.expansions_size);
+}
+END_TEST
+
+START_TEST(test_preprocessor_includes_headers)
+{
+    char *content = "#include \"/tmp/clink_test_guarded.h\"\n"
+                    "#include \"/tmp/clink_test_guarded.h\"\n"
+                    "#include <clink_test_plain.h>\n"
+                    "#include <clink_test_plain.h>\n"
+                    "GUARDED_H";
+    enum token_t expected[] = {
+        TOK_INT, TOK_IDENTIFIER, TOK_SEMICOLON,
+        TOK_INT, TOK_IDENTIFIER, TOK_SEMICOLON,
+        TOK_INT, TOK_IDENTIFIER, TOK_SEMICOLON,
+        TOK_EOF
+    };
+    struct preprocessor preprocessor;
+    FILE *f;
+    size_t i;
+
+    f = fopen("/tmp/clink_test_guarded.h", "w");
+    fputs("#ifndef GUARDED_H\n"
+          "#define GUARDED_H\n"
+          "int guarded;\n"
+          "#endif /* GUARDED_H */\n", f);
+    fclose(f);
+
+    f = fopen("/tmp/clink_test_plain.h", "w");
+    fputs("int plain;\n", f);
+    fclose(f);
+
+    add_include_directory("/tmp");
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+
+    for (i=0; i<sizeof(expected)/sizeof(expected[0]); i++)
+    {
+        ck_assert_int_eq(expected[i], preprocessor_next(&preprocessor)->type);
+    }
+
+    remove("/tmp/clink_test_guarded.h");
+    remove("/tmp/clink_test_plain.h");
+    release_headers();
+}
+END_TEST
+
+START_TEST(test_preprocessor_invokes_macros_across_headers)
+{
+    char *content = "#include \"/tmp/clink_test_invoke.h\"\n"
+                    "(x);\n"
+                    "F\n";
+    enum token_t expected[] = {
+        TOK_INT, TOK_IDENTIFIER, TOK_SEMICOLON,
+        TOK_IDENTIFIER, TOK_EOF
+    };
+    struct preprocessor preprocessor;
+    struct token *tok;
+    FILE *f;
+    size_t i;
+
+    /*
+     * The arguments of a function-like macro named at the end of a header
+     * may follow in the file that included it.
+     */
+    f = fopen("/tmp/clink_test_invoke.h", "w");
+    fputs("#define F(x) int x\n"
+          "F", f);
+    fclose(f);
+
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+
+    for (i=0; i<sizeof(expected)/sizeof(expected[0]); i++)
+    {
+        tok = preprocessor_next(&preprocessor);
+        ck_assert_int_eq(expected[i], tok->type);
+    }
+    ck_assert_int_eq(0, preprocessor.errors);
+
+    remove("/tmp/clink_test_invoke.h");
+    release_headers();
+}
+END_TEST
+
+START_TEST(test_preprocessor_stops_at_errors)
+{
+    char *header;
+    char *content = "int a;\n"
+                    "#error stop here\n"
+                    "int b;\n";
+    struct preprocessor preprocessor;
+
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+    ck_assert_int_eq(TOK_INT, preprocessor_next(&preprocessor)->type);
+    ck_assert_int_eq(TOK_IDENTIFIER, preprocessor_next(&preprocessor)->type);
+    ck_assert_int_eq(TOK_SEMICOLON, preprocessor_next(&preprocessor)->type);
+    ck_assert_int_eq(TOK_EOF, preprocessor_next(&preprocessor)->type);
+    ck_assert_int_eq(TOK_EOF, preprocessor_next(&preprocessor)->type);
+    ck_assert_int_eq(1, preprocessor.errors);
+
+    content = "#include \"/tmp/clink_test_missing.h\"\n"
+              "int c;\n";
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+    ck_assert_int_eq(TOK_EOF, preprocessor_next(&preprocessor)->type);
+    ck_assert_int_eq(1, preprocessor.errors);
+
+    /*
+     * Missing system headers are skipped rather than errors.
+     */
+    content = "#include <clink_test_missing.h>\n"
+              "int c;\n";
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+    ck_assert_int_eq(TOK_INT, preprocessor_next(&preprocessor)->type);
+    ck_assert_int_eq(0, preprocessor.errors);
+
+    /*
+     * Input that parses up to the error is still not compiled.
+     */
+    content = "int a;\n"
+              "#define F(x) x\n"
+              "int b = F(1, 2);\n";
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+    ck_assert_ptr_eq(NULL, parse(&preprocessor));
+    ck_assert_int_eq(1, preprocessor.errors);
+
+    /*
+     * So is input with a malformed token, unless it is in a group that is
+     * skipped, in the main file or in a header.
+     */
+    content = "int a = 0x;\n";
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+    ck_assert_ptr_eq(NULL, parse(&preprocessor));
+    ck_assert_int_eq(1, preprocessor.errors);
+
+    content = "#if 0\n"
+              "int a = 0x;\n"
+              "#endif\n"
+              "int b;\n";
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+    ck_assert_ptr_ne(NULL, parse(&preprocessor));
+    ck_assert_int_eq(0, preprocessor.errors);
+
+    header = "#if 0\n"
+             "int a = 09;\n"
+             "#endif\n";
+    write_file("/tmp/clink_test_skipped.h", header, strlen(header));
+    content = "#include \"/tmp/clink_test_skipped.h\"\n"
+              "int b;\n";
+    preprocessor_init(&preprocessor, NULL, content, strlen(content));
+    ck_assert_ptr_ne(NULL, parse(&preprocessor));
+    ck_assert_int_eq(0, preprocessor.errors);
+    remove("/tmp/clink_test_skipped.h");
+    release_headers();
+}
+END_TEST
+
 START_TEST(test_scanner_can_parse_integer_token)
 {
     char *content = "1234";
-    struct listnode *tokens;
-    list_init(&tokens);
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
 
     scan(content, strlen(content), &tokens);
 
-    ck_assert_int_eq(TOK_INTEGER, ((struct token *)tokens->data)->type);
-    ck_assert_str_eq("1234", ((struct token *)tokens->data)->value);
+    ck_assert_int_eq(TOK_INTEGER, tokens.tokens[0].type);
+    ck_assert_int_eq(1234, tokens.tokens[0].int_value);
 }
 END_TEST
 
 START_TEST(test_scanner_can_parse_string_token)
 {
     char *content = "abcd";
-    struct listnode *tokens;
-    list_init(&tokens);
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
 
     scan(content, strlen(content), &tokens);
 
-    ck_assert_int_eq(TOK_IDENTIFIER, ((struct token *)tokens->data)->type);
-    ck_assert_str_eq("abcd", ((struct token *)tokens->data)->value);
+    ck_assert_int_eq(TOK_IDENTIFIER, tokens.tokens[0].type);
+    ck_assert_str_eq("abcd", tokens.tokens[0].value);
 }
 END_TEST
 
 START_TEST(test_scanner_can_parse_literal_string_token)
 {
     char *content = "\"abcd\"";
-    struct listnode *tokens;
-    list_init(&tokens);
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
 
     scan(content, strlen(content), &tokens);
 
-    ck_assert_int_eq(TOK_STRING, ((struct token *)tokens->data)->type);
-    ck_assert_str_eq("abcd", ((struct token *)tokens->data)->value);
+    ck_assert_int_eq(TOK_STRING, tokens.tokens[0].type);
+    ck_assert_str_eq("abcd", tokens.tokens[0].value);
 }
 END_TEST
 
 START_TEST(test_scanner_can_parse_string_token_with_integers)
 {
     char *content = "abc123";
-    struct listnode *tokens;
-    list_init(&tokens);
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
 
     scan(content, strlen(content), &tokens);
 
-    ck_assert_int_eq(TOK_IDENTIFIER, ((struct token *)tokens->data)->type);
-    ck_assert_str_eq("abc123", ((struct token *)tokens->data)->value);
+    ck_assert_int_eq(TOK_IDENTIFIER, tokens.tokens[0].type);
+    ck_assert_str_eq("abc123", tokens.tokens[0].value);
 }
 END_TEST
 
 START_TEST(test_scanner_can_parse_paren)
 {
     char *content = "()";
-    struct listnode *tokens;
-    list_init(&tokens);
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
 
     scan(content, strlen(content), &tokens);
 
-    ck_assert_int_eq(TOK_LPAREN, ((struct token *)tokens->data)->type);
-    ck_assert_int_eq(TOK_RPAREN, ((struct token *)tokens->next->data)->type);
+    ck_assert_int_eq(TOK_LPAREN, tokens.tokens[0].type);
+    ck_assert_int_eq(TOK_RPAREN, tokens.tokens[1].type);
 }
 END_TEST
 
 START_TEST(test_scanner_can_parse_two_braces)
 {
     char *content = "{}";
-    struct listnode *tokens;
-    list_init(&tokens);
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
 
     scan(content, strlen(content), &tokens);
 
-    ck_assert_int_eq(TOK_LBRACE, ((struct token *)tokens->data)->type);
-    ck_assert_int_eq(TOK_RBRACE, ((struct token *)tokens->next->data)->type);
+    ck_assert_int_eq(TOK_LBRACE, tokens.tokens[0].type);
+    ck_assert_int_eq(TOK_RBRACE, tokens.tokens[1].type);
 }
 END_TEST
 
 START_TEST(test_scanner_can_parse_two_brackets)
 {
     char *content = "[]";
-    struct listnode *tokens;
-    list_init(&tokens);
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
 
     scan(content, strlen(content), &tokens);
 
-    ck_assert_int_eq(TOK_LBRACKET, ((struct token *)tokens->data)->type);
-    ck_assert_int_eq(TOK_RBRACKET, ((struct token *)tokens->next->data)->type);
+    ck_assert_int_eq(TOK_LBRACKET, tokens.tokens[0].type);
+    ck_assert_int_eq(TOK_RBRACKET, tokens.tokens[1].type);
 }
 END_TEST
 
 START_TEST(test_scanner_can_parse_special_characters)
 {
     char *content = ";=+*&'/%<>^|?:.";
-    struct listnode *tokens;
-    list_init(&tokens);
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
 
     scan(content, strlen(content), &tokens);
 
-    ck_assert_int_eq(TOK_SEMICOLON, ((struct token *)tokens->data)->type);
-    ck_assert_int_eq(TOK_EQUAL, ((struct token *)tokens->next->data)->type);
-    ck_assert_int_eq(TOK_PLUS, ((struct token *)tokens->next->next->data)->type);
-    ck_assert_int_eq(TOK_ASTERISK, ((struct token *)tokens->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_AMPERSAND, ((struct token *)tokens->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_SINGLEQUOTE, ((struct token *)tokens->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_BACKSLASH, ((struct token *)tokens->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_MOD, ((struct token *)tokens->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_LESSTHAN, ((struct token *)tokens->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_GREATERTHAN, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_CARET, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_VERTICALBAR, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_QUESTIONMARK, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_COLON, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_DOT, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
+    ck_assert_int_eq(TOK_SEMICOLON, tokens.tokens[0].type);
+    ck_assert_int_eq(TOK_EQUAL, tokens.tokens[1].type);
+    ck_assert_int_eq(TOK_PLUS, tokens.tokens[2].type);
+    ck_assert_int_eq(TOK_ASTERISK, tokens.tokens[3].type);
+    ck_assert_int_eq(TOK_AMPERSAND, tokens.tokens[4].type);
+    ck_assert_int_eq(TOK_SINGLEQUOTE, tokens.tokens[5].type);
+    ck_assert_int_eq(TOK_BACKSLASH, tokens.tokens[6].type);
+    ck_assert_int_eq(TOK_MOD, tokens.tokens[7].type);
+    ck_assert_int_eq(TOK_LESSTHAN, tokens.tokens[8].type);
+    ck_assert_int_eq(TOK_GREATERTHAN, tokens.tokens[9].type);
+    ck_assert_int_eq(TOK_CARET, tokens.tokens[10].type);
+    ck_assert_int_eq(TOK_VERTICALBAR, tokens.tokens[11].type);
+    ck_assert_int_eq(TOK_QUESTIONMARK, tokens.tokens[12].type);
+    ck_assert_int_eq(TOK_COLON, tokens.tokens[13].type);
+    ck_assert_int_eq(TOK_DOT, tokens.tokens[14].type);
 }
 END_TEST
 
 START_TEST(test_scanner_can_parse_combination_tokens)
 {
     char *content = "+++=---=->>><<<=>===!=&&||...";
-    struct listnode *tokens;
-    list_init(&tokens);
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
+
+    scan(content, strlen(content), &tokens);
+
+    ck_assert_int_eq(TOK_PLUS_PLUS, tokens.tokens[0].type);
+    ck_assert_int_eq(TOK_PLUS_EQUAL, tokens.tokens[1].type);
+    ck_assert_int_eq(TOK_MINUS_MINUS, tokens.tokens[2].type);
+    ck_assert_int_eq(TOK_MINUS_EQUAL, tokens.tokens[3].type);
+    ck_assert_int_eq(TOK_ARROW, tokens.tokens[4].type);
+    ck_assert_int_eq(TOK_SHIFTRIGHT, tokens.tokens[5].type);
+    ck_assert_int_eq(TOK_SHIFTLEFT, tokens.tokens[6].type);
+    ck_assert_int_eq(TOK_LESSTHANEQUAL, tokens.tokens[7].type);
+    ck_assert_int_eq(TOK_GREATERTHANEQUAL, tokens.tokens[8].type);
+    ck_assert_int_eq(TOK_EQ, tokens.tokens[9].type);
+    ck_assert_int_eq(TOK_NEQ, tokens.tokens[10].type);
+    ck_assert_int_eq(TOK_AMPERSAND_AMPERSAND, tokens.tokens[11].type);
+    ck_assert_int_eq(TOK_VERTICALBAR_VERTICALBAR, tokens.tokens[12].type);
+    ck_assert_int_eq(TOK_ELLIPSIS, tokens.tokens[13].type);
+}
+END_TEST
+
+START_TEST(test_scanner_converts_integer_constants)
+{
+    char *content = "0 017 0x1F 0XfF 42u 42L 42ul 42LLU 18446744073709551615";
+    struct token_buffer tokens;
+    struct scanner scanner;
+    struct token *token;
+    token_buffer_init(&tokens);
 
     scan(content, strlen(content), &tokens);
 
-    ck_assert_int_eq(TOK_PLUS_PLUS, ((struct token *)tokens->data)->type);
-    ck_assert_int_eq(TOK_PLUS_EQUAL, ((struct token *)tokens->next->data)->type);
-    ck_assert_int_eq(TOK_MINUS_MINUS, ((struct token *)tokens->next->next->data)->type);
-    ck_assert_int_eq(TOK_MINUS_EQUAL, ((struct token *)tokens->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_ARROW, ((struct token *)tokens->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_SHIFTRIGHT, ((struct token *)tokens->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_SHIFTLEFT, ((struct token *)tokens->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_LESSTHANEQUAL, ((struct token *)tokens->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_GREATERTHANEQUAL, ((struct token *)tokens->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_EQ, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_NEQ, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_AMPERSAND_AMPERSAND, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_VERTICALBAR_VERTICALBAR, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_ELLIPSIS, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
+    ck_assert_int_eq(10, tokens.size);
+    ck_assert_int_eq(0, tokens.tokens[0].int_value);
+    ck_assert_int_eq(15, tokens.tokens[1].int_value);
+    ck_assert_int_eq(31, tokens.tokens[2].int_value);
+    ck_assert_int_eq(255, tokens.tokens[3].int_value);
+
+    ck_assert_int_eq(42, tokens.tokens[4].int_value);
+    ck_assert_int_eq(TOKEN_UNSIGNED, tokens.tokens[4].flags & TOKEN_SUFFIXES);
+    ck_assert_int_eq(TOKEN_LONG, tokens.tokens[5].flags & TOKEN_SUFFIXES);
+    ck_assert_int_eq(TOKEN_UNSIGNED | TOKEN_LONG,
+                     tokens.tokens[6].flags & TOKEN_SUFFIXES);
+    ck_assert_int_eq(TOKEN_UNSIGNED | TOKEN_LONG_LONG,
+                     tokens.tokens[7].flags & TOKEN_SUFFIXES);
+
+    ck_assert(tokens.tokens[8].int_value == 18446744073709551615ULL);
+    ck_assert_int_eq(0, tokens.tokens[8].flags & TOKEN_SUFFIXES);
+    ck_assert_int_eq(TOK_EOF, tokens.tokens[9].type);
+
+    /*
+     * Constants too large for 64 bits saturate and are malformed, as are
+     * hexadecimal constants without digits and octal constants with 8 or 9.
+     */
+    content = "18446744073709551616";
+    scanner_init(&scanner, content, strlen(content));
+    token = next_token(&scanner);
+    ck_assert(token->int_value == 18446744073709551615ULL);
+    ck_assert_int_eq(TOKEN_TOO_LARGE, token->flags & TOKEN_MALFORMED);
+
+    content = "0x1 0x;";
+    scanner_init(&scanner, content, strlen(content));
+    token = next_token(&scanner);
+    ck_assert_int_eq(1, token->int_value);
+    ck_assert_int_eq(0, token->flags & TOKEN_MALFORMED);
+    token = next_token(&scanner);
+    ck_assert_int_eq(TOK_INTEGER, token->type);
+    ck_assert_int_eq(TOKEN_NO_DIGITS, token->flags & TOKEN_MALFORMED);
+    ck_assert_int_eq(TOK_SEMICOLON, next_token(&scanner)->type);
+
+    content = "09";
+    scanner_init(&scanner, content, strlen(content));
+    token = next_token(&scanner);
+    ck_assert_int_eq(TOKEN_BAD_DIGIT, token->flags & TOKEN_MALFORMED);
 }
 END_TEST
 
 START_TEST(test_scanner_ignores_comment_contents)
 {
     char *content = "123/*456*/789";
-    struct listnode *tokens;
-    list_init(&tokens);
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
 
     scan(content, strlen(content), &tokens);
 
-    ck_assert_int_eq(TOK_INTEGER, ((struct token *)tokens->data)->type);
-    ck_assert_str_eq("123", ((struct token *)tokens->data)->value);
-    ck_assert_str_eq("789", ((struct token *)tokens->next->data)->value);
+    ck_assert_int_eq(TOK_INTEGER, tokens.tokens[0].type);
+    ck_assert_int_eq(123, tokens.tokens[0].int_value);
+    ck_assert_int_eq(789, tokens.tokens[1].int_value);
 }
 END_TEST
 
 START_TEST(test_scanner_ignores_comment_contents_around_strings)
 {
     char *content = "abc/*def*/ghi";
-    struct listnode *tokens;
-    list_init(&tokens);
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
 
     scan(content, strlen(content), &tokens);
 
-    ck_assert_int_eq(TOK_IDENTIFIER, ((struct token *)tokens->data)->type);
-    ck_assert_str_eq("abc", ((struct token *)tokens->data)->value);
-    ck_assert_str_eq("ghi", ((struct token *)tokens->next->data)->value);
+    ck_assert_int_eq(TOK_IDENTIFIER, tokens.tokens[0].type);
+    ck_assert_str_eq("abc", tokens.tokens[0].value);
+    ck_assert_str_eq("ghi", tokens.tokens[1].value);
 }
 END_TEST
 
 START_TEST(test_scanner_ignores_comment_contents_that_contant_asterisks)
 {
     char *content = "abc/*d*e*f*/ghi";
-    struct listnode *tokens;
-    list_init(&tokens);
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
 
     scan(content, strlen(content), &tokens);
 
-    ck_assert_int_eq(TOK_IDENTIFIER, ((struct token *)tokens->data)->type);
-    ck_assert_str_eq("abc", ((struct token *)tokens->data)->value);
-    ck_assert_str_eq("ghi", ((struct token *)tokens->next->data)->value);
+    ck_assert_int_eq(TOK_IDENTIFIER, tokens.tokens[0].type);
+    ck_assert_str_eq("abc", tokens.tokens[0].value);
+    ck_assert_str_eq("ghi", tokens.tokens[1].value);
+}
+END_TEST
+
+START_TEST(test_scanner_reserved_words_have_their_own_slots)
+{
+    static const struct
+    {
+        const char *name;
+        enum token_t type;
+    } words[] =
+    {
+        { "auto", TOK_AUTO }, { "break", TOK_BREAK }, { "case", TOK_CASE },
+        { "char", TOK_CHAR }, { "const", TOK_CONST },
+        { "continue", TOK_CONTINUE }, { "default", TOK_DEFAULT },
+        { "do", TOK_DO }, { "double", TOK_DOUBLE }, { "else", TOK_ELSE },
+        { "enum", TOK_ENUM }, { "extern", TOK_EXTERN },
+        { "float", TOK_FLOAT }, { "for", TOK_FOR }, { "goto", TOK_GOTO },
+        { "if", TOK_IF }, { "int", TOK_INT }, { "long", TOK_LONG },
+        { "register", TOK_REGISTER }, { "return", TOK_RETURN },
+        { "short", TOK_SHORT }, { "signed", TOK_SIGNED },
+        { "static", TOK_STATIC }, { "struct", TOK_STRUCT },
+        { "switch", TOK_SWITCH }, { "typedef", TOK_TYPEDEF },
+        { "union", TOK_UNION }, { "unsigned", TOK_UNSIGNED },
+        { "void", TOK_VOID }, { "volatile", TOK_VOLATILE },
+        { "while", TOK_WHILE },
+    };
+    struct scanner scanner;
+    char name[16];
+    size_t i, length;
+
+    /*
+     * Every reserved word is found in the slot it hashes to, and a word
+     * that hashes to the same slot, with the same first and last characters
+     * and length, is an identifier.
+     */
+    for (i=0; i<sizeof(words)/sizeof(words[0]); i++)
+    {
+        scanner_init(&scanner, (char *)words[i].name, strlen(words[i].name));
+        ck_assert_int_eq(words[i].type, next_token(&scanner)->type);
+
+        length = strlen(words[i].name);
+        if (length > 2)
+        {
+            memcpy(name, words[i].name, length);
+            name[1] = 'Q';
+            scanner_init(&scanner, name, length);
+            ck_assert_int_eq(TOK_IDENTIFIER, next_token(&scanner)->type);
+        }
+    }
 }
 END_TEST
 
 START_TEST(test_scanner_can_parse_reserved_words)
 {
     char *content = "int char goto  continue break  return if else switch case default enum struct union const volatile void short long float double signed unsigned";
-    struct listnode *tokens;
-    list_init(&tokens);
+    struct token_buffer tokens;
+    token_buffer_init(&tokens);
 
     scan(content, strlen(content), &tokens);
 
-    ck_assert_int_eq(TOK_INT, ((struct token *)tokens->data)->type);
-    ck_assert_int_eq(TOK_CHAR, ((struct token *)tokens->next->data)->type);
-    ck_assert_int_eq(TOK_GOTO, ((struct token *)tokens->next->next->data)->type);
-    ck_assert_int_eq(TOK_CONTINUE, ((struct token *)tokens->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_BREAK, ((struct token *)tokens->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_RETURN, ((struct token *)tokens->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_IF, ((struct token *)tokens->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_ELSE, ((struct token *)tokens->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_SWITCH, ((struct token *)tokens->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_CASE, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_DEFAULT, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_ENUM, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_STRUCT, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_UNION, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_CONST, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_VOLATILE, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_VOID, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_SHORT, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_LONG, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_FLOAT, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_DOUBLE, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_SIGNED, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
-    ck_assert_int_eq(TOK_UNSIGNED, ((struct token *)tokens->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->next->data)->type);
+    ck_assert_int_eq(TOK_INT, tokens.tokens[0].type);
+    ck_assert_int_eq(TOK_CHAR, tokens.tokens[1].type);
+    ck_assert_int_eq(TOK_GOTO, tokens.tokens[2].type);
+    ck_assert_int_eq(TOK_CONTINUE, tokens.tokens[3].type);
+    ck_assert_int_eq(TOK_BREAK, tokens.tokens[4].type);
+    ck_assert_int_eq(TOK_RETURN, tokens.tokens[5].type);
+    ck_assert_int_eq(TOK_IF, tokens.tokens[6].type);
+    ck_assert_int_eq(TOK_ELSE, tokens.tokens[7].type);
+    ck_assert_int_eq(TOK_SWITCH, tokens.tokens[8].type);
+    ck_assert_int_eq(TOK_CASE, tokens.tokens[9].type);
+    ck_assert_int_eq(TOK_DEFAULT, tokens.tokens[10].type);
+    ck_assert_int_eq(TOK_ENUM, tokens.tokens[11].type);
+    ck_assert_int_eq(TOK_STRUCT, tokens.tokens[12].type);
+    ck_assert_int_eq(TOK_UNION, tokens.tokens[13].type);
+    ck_assert_int_eq(TOK_CONST, tokens.tokens[14].type);
+    ck_assert_int_eq(TOK_VOLATILE, tokens.tokens[15].type);
+    ck_assert_int_eq(TOK_VOID, tokens.tokens[16].type);
+    ck_assert_int_eq(TOK_SHORT, tokens.tokens[17].type);
+    ck_assert_int_eq(TOK_LONG, tokens.tokens[18].type);
+    ck_assert_int_eq(TOK_FLOAT, tokens.tokens[19].type);
+    ck_assert_int_eq(TOK_DOUBLE, tokens.tokens[20].type);
+    ck_assert_int_eq(TOK_SIGNED, tokens.tokens[21].type);
+    ck_assert_int_eq(TOK_UNSIGNED, tokens.tokens[22].type);
 }
 END_TEST
 
+START_TEST(test_scanner_can_parse_remaining_reserved_words)
+{
+    char *content = "for do while auto register static extern typedef "
+                    "integer in fo whiles typedefs x";
+    enum token_t expected[] =
+    {
+        TOK_FOR, TOK_DO, TOK_WHILE, TOK_AUTO, TOK_REGISTER, TOK_STATIC,
+        TOK_EXTERN, TOK_TYPEDEF, TOK_IDENTIFIER, TOK_IDENTIFIER,
+        TOK_IDENTIFIER, TOK_IDENTIFIER, TOK_IDENTIFIER, TOK_IDENTIFIER,
+        TOK_EOF
+    };
+    struct token_buffer tokens;
+    int i;
+    token_buffer_init(&tokens);
+
+    scan(content, strlen(content), &tokens);
+
+    ck_assert_int_eq(sizeof(expected) / sizeof(expected[0]), tokens.size);
+    for (i=0; i<tokens.size; i++)
+    {
+        ck_assert_int_eq(expected[i], tokens.tokens[i].type);
+    }
+}
+END_TEST
 
 int
 main(void)
@@ -972,23 +1923,35 @@ main(void)
     SRunner *runner = srunner_create(suite);
 
     suite_add_tcase(suite, testcase);
-    tcase_add_test(testcase, test_head_terminal_values_on_constant);
-    tcase_add_test(testcase, test_head_terminal_values_on_primary_expression);
-    tcase_add_test(testcase, test_head_terminal_values_on_postfix_expression);
-    tcase_add_test(testcase, test_head_terminal_values_on_unary_expression);
-    tcase_add_test(testcase, test_head_terminal_values_on_cast_expression);
-    tcase_add_test(testcase, test_head_terminal_values_on_multiplicative_expression);
-    tcase_add_test(testcase, test_head_terminal_values_on_additive_expression);
-    tcase_add_test(testcase, test_head_terminal_values_on_shift_expression);
-    tcase_add_test(testcase, test_head_terminal_values_on_relational_expression);
-    tcase_add_test(testcase, test_head_terminal_values_on_specifier_qualifier_list);
-    tcase_add_test(testcase, test_generate_items_on_constant);
-    tcase_add_test(testcase, test_generate_items_on_primary_expression);
-    tcase_add_test(testcase, test_generate_items_on_postfix_expression);
-    tcase_add_test(testcase, test_generate_items_on_unary_expression);
+    tcase_add_test(testcase, test_first_set_on_constant);
+    tcase_add_test(testcase, test_first_set_on_primary_expression);
+    tcase_add_test(testcase, test_first_set_on_postfix_expression);
+    tcase_add_test(testcase, test_first_set_on_unary_expression);
+    tcase_add_test(testcase, test_first_set_on_cast_expression);
+    tcase_add_test(testcase, test_first_set_on_multiplicative_expression);
+    tcase_add_test(testcase, test_first_set_on_additive_expression);
+    tcase_add_test(testcase, test_first_set_on_shift_expression);
+    tcase_add_test(testcase, test_first_set_on_relational_expression);
+    tcase_add_test(testcase, test_first_set_on_specifier_qualifier_list);
+    tcase_add_test(testcase, test_first_of_sequence_uses_follow_only_when_nullable);
+    tcase_add_test(testcase, test_lookahead_union_and_equal);
+    tcase_add_test(testcase, test_generate_closure_on_constant);
+    tcase_add_test(testcase, test_generate_closure_on_primary_expression);
+    tcase_add_test(testcase, test_generate_closure_on_postfix_expression);
+    tcase_add_test(testcase, test_generate_closure_on_unary_expression);
+    tcase_add_test(testcase, test_item_cores_are_dense);
     tcase_add_test(testcase, test_generate_transitions_increments_cursor_position);
+    tcase_add_test(testcase, test_parsetable_action_in_initial_state);
+    tcase_add_test(testcase, test_load_parsetable_matches_compiled_table);
+    tcase_add_test(testcase, test_load_parsetable_rejects_other_grammar);
+    tcase_add_test(testcase, test_load_parsetable_rejects_corrupt_tables);
+    tcase_add_test(testcase, test_grammar_hash_covers_elided_rules);
+    tcase_add_test(testcase, test_genpt_elides_unit_rules_from_clr_table);
+    tcase_add_test(testcase, test_token_to_astnode);
     tcase_add_test(testcase, test_parser_can_parse_simple_declaration);
     tcase_add_test(testcase, test_parser_can_parse_multiple_simple_declarations);
+    tcase_add_test(testcase, test_parser_gives_elided_nodes_their_types);
+    tcase_add_test(testcase, test_parser_reports_syntax_errors);
     tcase_add_test(testcase, test_parser_can_parse_primary_expressions);
     tcase_add_test(testcase, test_parser_can_parse_function);
     tcase_add_test(testcase, test_parser_can_parse_function_calls);
@@ -998,8 +1961,24 @@ main(void)
     tcase_add_test(testcase, test_parser_can_parse_arithmatic_statements);
     tcase_add_test(testcase, test_parser_can_parse_conditional_statements);
     tcase_add_test(testcase, test_parser_can_parse_assigment_operations);
+    tcase_add_test(testcase, test_parser_can_parse_deeply_nested_expressions);
+    tcase_add_test(testcase, test_create_binary_op_reads_children_in_rule_order);
     tcase_add_test(testcase, test_list_append);
     tcase_add_test(testcase, test_list_item);
+    tcase_add_test(testcase, test_arena_alloc_is_zeroed_and_aligned);
+    tcase_add_test(testcase, test_arena_realloc_keeps_contents);
+    tcase_add_test(testcase, test_intern_returns_shared_strings);
+    tcase_add_test(testcase, test_scanner_interns_identifiers);
+    tcase_add_test(testcase, test_scanner_records_token_offsets);
+    tcase_add_test(testcase, test_scanner_skips_unknown_characters_and_whitespace_runs);
+    tcase_add_test(testcase, test_scanner_skips_long_comments_whitespace_and_strings);
+    tcase_add_test(testcase, test_scanner_produces_tokens_on_demand);
+    tcase_add_test(testcase, test_scanner_converts_integer_constants);
+    tcase_add_test(testcase, test_preprocessor_expands_macros_and_conditionals);
+    tcase_add_test(testcase, test_preprocessor_rescans_expansions_with_following_tokens);
+    tcase_add_test(testcase, test_preprocessor_includes_headers);
+    tcase_add_test(testcase, test_preprocessor_invokes_macros_across_headers);
+    tcase_add_test(testcase, test_preprocessor_stops_at_errors);
     tcase_add_test(testcase, test_scanner_can_parse_integer_token);
     tcase_add_test(testcase, test_scanner_can_parse_string_token);
     tcase_add_test(testcase, test_scanner_can_parse_literal_string_token);
@@ -1013,6 +1992,8 @@ main(void)
     tcase_add_test(testcase, test_scanner_ignores_comment_contents_around_strings);
     tcase_add_test(testcase, test_scanner_ignores_comment_contents_that_contant_asterisks);
     tcase_add_test(testcase, test_scanner_can_parse_reserved_words);
+    tcase_add_test(testcase, test_scanner_reserved_words_have_their_own_slots);
+    tcase_add_test(testcase, test_scanner_can_parse_remaining_reserved_words);
 
     srunner_run_all(runner, CK_ENV);
     return 0;
@@ -1,9 +1,71 @@
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "utilities.h"
 
+/*
+ * arena_chunk is the header of a chunk of arena memory. The memory handed out
+ * follows the header. last is the offset of the most recent allocation in the
+ * chunk so that it can be grown in place.
+ */
+struct arena_chunk
+{
+    struct arena_chunk *next;
+    size_t size;
+    size_t used;
+    size_t last;
+};
+
+#define ARENA_ROUND(size) \
+    (((size) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+#define ARENA_HEADER_SIZE ARENA_ROUND(sizeof(struct arena_chunk))
+#define ARENA_DATA(chunk) ((char *)(chunk) + ARENA_HEADER_SIZE)
+
+/*
+ * arena_chunks is the list of chunks in the arena. Allocations are bumped out
+ * of the first chunk.
+ */
+static struct arena_chunk *arena_chunks = NULL;
+
+/*
+ * intern_table is an open addressing hash table of the interned strings. It
+ * doubles in size whenever it becomes half full. Unlike the arena, the table
+ * and the strings in intern_chunks are kept for the life of the process, so
+ * that tokens cached from one translation unit are still valid in the next.
+ */
+struct interned_string
+{
+    unsigned long hash;
+    const char *str;
+    size_t length;
+};
+
+static struct interned_string *intern_table = NULL;
+static size_t intern_table_size = 0;
+static size_t intern_count = 0;
+static struct arena_chunk *intern_chunks = NULL;
+
+static struct arena_chunk *
+arena_new_chunk(size_t size)
+{
+    struct arena_chunk *chunk;
+
+    /*
+     * Chunks are never reused after arena_release() so calloc is enough to
+     * hand out zeroed memory.
+     */
+    chunk = calloc(1, ARENA_HEADER_SIZE + size);
+    assert(chunk != NULL);
+    chunk->size = size;
+    return chunk;
+}
+
 void
 list_init(
     struct listnode **head)
@@ -16,7 +78,7 @@ list_prepend(
     struct listnode **head,
     void *data)
 {
-    struct listnode *t = malloc(sizeof(struct listnode));
+    struct listnode *t = arena_alloc(sizeof(struct listnode));
     t->data = data;
     t->next = *head;
 
@@ -33,7 +95,7 @@ list_append(
     struct listnode **head,
     void *data)
 {
-    struct listnode *t = malloc(sizeof(struct listnode));
+    struct listnode *t = arena_alloc(sizeof(struct listnode));
     t->data = data;
     t->next = NULL;
 
@@ -67,7 +129,7 @@ int
 list_equal(struct listnode *a, struct listnode *b)
 {
     struct listnode *_a, *_b;
-    int match = 0;
+    int match;
 
     if (a == b)
     {
@@ -76,6 +138,7 @@ list_equal(struct listnode *a, struct listnode *b)
 
     for (_a=a; _a!=NULL; _a=_a->next)
     {
+        match = 0;
         for (_b=b; _b!=NULL; _b=_b->next)
         {
             if (_a->data == _b->data)
@@ -96,6 +159,7 @@ list_equal(struct listnode *a, struct listnode *b)
 
     for (_b=b; _b!=NULL; _b=_b->next)
     {
+        match = 0;
         for (_a=a; _a!=NULL; _a=_a->next)
         {
             if (_a->data == _b->data)
@@ -116,3 +180,302 @@ list_equal(struct listnode *a, struct listnode *b)
 
     return 1;
 }
+
+void *
+arena_alloc(size_t size)
+{
+    struct arena_chunk *chunk;
+
+    size = ARENA_ROUND(size);
+
+    if (size > ARENA_CHUNK_SIZE / 4)
+    {
+        /*
+         * Large allocations get a chunk of their own behind the current chunk
+         * so that the space left in the current chunk is not wasted.
+         */
+        chunk = arena_new_chunk(size);
+        chunk->used = size;
+        if (arena_chunks != NULL)
+        {
+            chunk->next = arena_chunks->next;
+            arena_chunks->next = chunk;
+        }
+        else
+        {
+            arena_chunks = chunk;
+        }
+        return ARENA_DATA(chunk);
+    }
+
+    chunk = arena_chunks;
+    if (chunk == NULL || chunk->size - chunk->used < size)
+    {
+        chunk = arena_new_chunk(ARENA_CHUNK_SIZE);
+        chunk->next = arena_chunks;
+        arena_chunks = chunk;
+    }
+
+    chunk->last = chunk->used;
+    chunk->used += size;
+    return ARENA_DATA(chunk) + chunk->last;
+}
+
+/*
+ * Grow or shrink an arena allocation of old_size bytes. The most recent
+ * allocation is resized in place when it fits, otherwise the contents are
+ * copied to a new allocation.
+ */
+void *
+arena_realloc(void *ptr, size_t old_size, size_t size)
+{
+    struct arena_chunk *chunk = arena_chunks;
+    void *resized;
+
+    if (ptr == NULL)
+    {
+        return arena_alloc(size);
+    }
+
+    if (chunk != NULL && ptr == ARENA_DATA(chunk) + chunk->last &&
+        ARENA_ROUND(size) <= chunk->size - chunk->last)
+    {
+        chunk->used = chunk->last + ARENA_ROUND(size);
+        return ptr;
+    }
+
+    resized = arena_alloc(size);
+    memcpy(resized, ptr, old_size < size ? old_size : size);
+    return resized;
+}
+
+/*
+ * Copy length characters of str into the arena and NUL terminate them.
+ */
+char *
+arena_strndup(const char *str, size_t length)
+{
+    char *copy = arena_alloc(length + 1);
+
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+void
+arena_release(void)
+{
+    struct arena_chunk *chunk, *next;
+
+    for (chunk=arena_chunks; chunk!=NULL; chunk=next)
+    {
+        next = chunk->next;
+        free(chunk);
+    }
+    arena_chunks = NULL;
+}
+
+static unsigned long
+intern_hash(const char *str, size_t length)
+{
+    unsigned long hash = 14695981039346656037UL;
+    size_t i;
+
+    for (i=0; i<length; i++)
+    {
+        hash ^= (unsigned char)str[i];
+        hash *= 1099511628211UL;
+    }
+    return hash;
+}
+
+static void
+intern_grow(void)
+{
+    struct interned_string *old_table = intern_table;
+    size_t old_size = intern_table_size;
+    size_t i, j;
+
+    intern_table_size = old_size ? old_size * 2 : INTERN_TABLE_INITIAL_SIZE;
+    intern_table = calloc(intern_table_size, sizeof(struct interned_string));
+    assert(intern_table != NULL);
+
+    for (i=0; i<old_size; i++)
+    {
+        if (old_table[i].str == NULL)
+        {
+            continue;
+        }
+
+        j = old_table[i].hash & (intern_table_size - 1);
+        while (intern_table[j].str != NULL)
+        {
+            j = (j + 1) & (intern_table_size - 1);
+        }
+        intern_table[j] = old_table[i];
+    }
+
+    free(old_table);
+}
+
+/*
+ * Copy length characters of str into intern_chunks and NUL terminate them.
+ */
+static char *
+intern_strndup(const char *str, size_t length)
+{
+    struct arena_chunk *chunk = intern_chunks;
+    char *copy;
+
+    if (chunk == NULL || chunk->size - chunk->used < length + 1)
+    {
+        chunk = arena_new_chunk(length + 1 > ARENA_CHUNK_SIZE ?
+                                length + 1 : ARENA_CHUNK_SIZE);
+        chunk->next = intern_chunks;
+        intern_chunks = chunk;
+    }
+
+    copy = ARENA_DATA(chunk) + chunk->used;
+    chunk->used += length + 1;
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+/*
+ * Returns the interned copy of length characters of str, adding it to the
+ * table the first time it is seen.
+ */
+const char *
+intern(const char *str, size_t length)
+{
+    unsigned long hash = intern_hash(str, length);
+    struct interned_string *entry;
+    size_t i;
+
+    if (intern_count * 2 >= intern_table_size)
+    {
+        intern_grow();
+    }
+
+    i = hash & (intern_table_size - 1);
+    for (;;)
+    {
+        entry = &intern_table[i];
+        if (entry->str == NULL)
+        {
+            break;
+        }
+        if (entry->hash == hash && entry->length == length &&
+            memcmp(entry->str, str, length) == 0)
+        {
+            return entry->str;
+        }
+        i = (i + 1) & (intern_table_size - 1);
+    }
+
+    entry->hash = hash;
+    entry->str = intern_strndup(str, length);
+    entry->length = length;
+    intern_count++;
+
+    return entry->str;
+}
+
+static int
+read_source(int fd, struct source *source)
+{
+    size_t done = 0;
+    ssize_t n;
+
+    source->content = malloc(source->length + 1);
+    if (source->content == NULL)
+    {
+        return 0;
+    }
+
+    while (done < source->length)
+    {
+        n = read(fd, &source->content[done], source->length - done);
+        if (n <= 0)
+        {
+            free(source->content);
+            return 0;
+        }
+        done += n;
+    }
+
+    source->content[source->length] = '\0';
+    source->mapped_size = 0;
+    return 1;
+}
+
+/*
+ * Map a source file read-only without copying it. The mapping is reserved
+ * with anonymous zeroed pages one byte larger than the file and the file is
+ * mapped over the start of it. The kernel zero fills the rest of the last
+ * file page, and when the file ends on a page boundary the byte after it is
+ * in the anonymous page, so either way content[length] is a NUL. Falls back
+ * to reading the file if it can't be mapped. Returns 0 if the file can't be
+ * opened or read.
+ */
+int
+open_source(const char *filename, struct source *source)
+{
+    struct stat st;
+    size_t page_size;
+    void *reserve;
+    int fd;
+    int ok;
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        return 0;
+    }
+
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        close(fd);
+        return 0;
+    }
+
+    source->length = st.st_size;
+    page_size = sysconf(_SC_PAGESIZE);
+    source->mapped_size = (source->length + page_size) & ~(page_size - 1);
+
+    reserve = mmap(NULL, source->mapped_size, PROT_READ,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserve == MAP_FAILED)
+    {
+        ok = read_source(fd, source);
+    }
+    else if (source->length == 0 ||
+             mmap(reserve, source->length, PROT_READ, MAP_PRIVATE | MAP_FIXED,
+                  fd, 0) != MAP_FAILED)
+    {
+        source->content = reserve;
+        ok = 1;
+    }
+    else
+    {
+        munmap(reserve, source->mapped_size);
+        ok = read_source(fd, source);
+    }
+
+    close(fd);
+    return ok;
+}
+
+void
+close_source(struct source *source)
+{
+    if (source->mapped_size)
+    {
+        munmap(source->content, source->mapped_size);
+    }
+    else
+    {
+        free(source->content);
+    }
+}
@@ -1,6 +1,8 @@
 #ifndef __UTILITIES_H__
 #define __UTILITIES_H__
 
+#include <stddef.h>
+
 struct pair
 {
     char *key;
@@ -29,4 +31,44 @@ void *list_item(struct listnode **head, int index);
 
 int list_equal(struct listnode *a, struct listnode *b);
 
+/*
+ * The arena holds the tokens, strings, AST nodes and list nodes built while
+ * compiling a translation unit. Memory is carved out of large chunks, is
+ * zero-initialized and is only released all at once by arena_release().
+ */
+#define ARENA_CHUNK_SIZE (64 * 1024)
+#define ARENA_ALIGNMENT 16
+
+void *arena_alloc(size_t size);
+
+void *arena_realloc(void *ptr, size_t old_size, size_t size);
+
+char *arena_strndup(const char *str, size_t length);
+
+void arena_release(void);
+
+/*
+ * Interned strings are stored once so that equal strings can be compared by
+ * pointer. They are not part of the arena and live until the process exits.
+ */
+#define INTERN_TABLE_INITIAL_SIZE 1024
+
+const char *intern(const char *str, size_t length);
+
+/*
+ * A source file mapped by open_source(). content[length] is always a NUL
+ * sentinel. mapped_size is the size of the mapping holding the file, or zero
+ * if it had to be read into a heap buffer instead.
+ */
+struct source
+{
+    char *content;
+    size_t length;
+    size_t mapped_size;
+};
+
+int open_source(const char *filename, struct source *source);
+
+void close_source(struct source *source);
+
 #endif